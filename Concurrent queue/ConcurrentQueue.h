@@ -0,0 +1,42 @@
+#ifndef __CONCURRENT_QUEUE_H_INCLUDED__
+#define __CONCURRENT_QUEUE_H_INCLUDED__
+
+#include "QueuePolicies.h"
+#include <optional>
+#include <utility>
+
+namespace IDragnev::Multithreading
+{
+	//One interface over the queues of the repo, so that a caller can switch
+	//implementations by changing the Policy alone (see QueuePolicies.h).
+	//push fails once the queue is closed; waitAndPop drains the queue after
+	//it is closed and then returns std::nullopt as end of stream.
+	template <typename T, typename Policy = TwoLock>
+	class ConcurrentQueue
+	{
+	private:
+		using Backend = typename Policy::template Backend<T>;
+
+	public:
+		ConcurrentQueue() = default;
+		//the arguments of the backend, such as the capacity of bounded ones
+		template <typename... Args>
+		explicit ConcurrentQueue(Args&&... args) : backend(std::forward<Args>(args)...) { }
+		ConcurrentQueue(const ConcurrentQueue&) = delete;
+		~ConcurrentQueue() = default;
+
+		ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+		bool push(T item) { return backend.push(std::move(item)); }
+		std::optional<T> tryPop() { return backend.tryPop(); }
+		std::optional<T> waitAndPop() { return backend.waitAndPop(); }
+
+		void close() { backend.close(); }
+		bool isClosed() const { return backend.isClosed(); }
+
+	private:
+		Backend backend;
+	};
+}
+
+#endif //__CONCURRENT_QUEUE_H_INCLUDED__
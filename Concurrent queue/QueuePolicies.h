@@ -0,0 +1,128 @@
+#ifndef __QUEUE_POLICIES_H_INCLUDED__
+#define __QUEUE_POLICIES_H_INCLUDED__
+
+#include "SpscRingQueue.h"
+#include "Condition variables\Condition variables\ThreadSafeQueue.h"
+#include "Fine-grained unbounded thread-safe queue\Thread-safe queue\Thread-safe queue\ThreadSafeQueue.h"
+#include "Lock-free data structures\Queue\Queue\LockFreeQueue.h"
+#include <optional>
+#include <utility>
+
+//The backends of ConcurrentQueue. Every policy names a Backend template
+//which adapts one of the queues in the repo to the same interface:
+//    bool push(T item);
+//    std::optional<T> tryPop();
+//    std::optional<T> waitAndPop();
+//    void close();
+//    bool isClosed() const;
+namespace IDragnev::Multithreading
+{
+	//one mutex and a condition variable around a single container
+	struct SingleLock
+	{
+		static constexpr auto name = "single lock";
+
+		template <typename T>
+		class Backend
+		{
+		public:
+			bool push(T item) { return queue.insertBack(std::move(item)); }
+			std::optional<T> tryPop() { return queue.tryToExtractFront(); }
+			std::optional<T> waitAndPop() { return queue.waitAndExtractFront(); }
+			void close() { queue.close(); }
+			bool isClosed() const { return queue.isClosed(); }
+
+		private:
+			IDragnev::Threads::ThreadSafeQueue<T> queue;
+		};
+	};
+
+	//a linked list with separate head and tail locks and pooled nodes,
+	//optionally bounded
+	struct TwoLock
+	{
+		static constexpr auto name = "two locks";
+
+		template <typename T>
+		class Backend
+		{
+		private:
+			using Queue = ThreadSafeQueue<T, InlineStorage>;
+
+		public:
+			Backend() = default;
+			explicit Backend(std::size_t capacity) : queue(capacity) { }
+
+			bool push(T item) { return queue.insertBack(std::move(item)); }
+			std::optional<T> tryPop() { return queue.tryToExtractFront(); }
+			std::optional<T> waitAndPop() { return queue.waitAndExtractFront(); }
+			void close() { queue.close(); }
+			bool isClosed() const { return queue.isClosed(); }
+
+		private:
+			Queue queue;
+		};
+	};
+
+	//the lock-free multi-producer multi-consumer LockFreeQueue;
+	//pushes racing with close may still succeed
+	struct LockFreeMpmc
+	{
+		static constexpr auto name = "lock-free MPMC";
+
+		template <typename T>
+		class Backend
+		{
+		public:
+			bool push(T item)
+			{
+				if (queue.isClosed())
+				{
+					return false;
+				}
+
+				queue.enqueue(std::move(item));
+				return true;
+			}
+
+			std::optional<T> tryPop() { return toOptional(queue.extractFront()); }
+			std::optional<T> waitAndPop() { return toOptional(queue.waitAndExtractFront()); }
+			void close() { queue.close(); }
+			bool isClosed() const { return queue.isClosed(); }
+
+		private:
+			static std::optional<T> toOptional(std::unique_ptr<T> item)
+			{
+				return item != nullptr ? std::optional<T>{ std::move(*item) } : std::nullopt;
+			}
+
+		private:
+			LockFreeQueue<T> queue;
+		};
+	};
+
+	//a bounded ring for exactly one producer and one consumer thread
+	struct Spsc
+	{
+		static constexpr auto name = "SPSC ring";
+
+		template <typename T>
+		class Backend
+		{
+		public:
+			Backend() = default;
+			explicit Backend(std::size_t capacity) : queue(capacity) { }
+
+			bool push(T item) { return queue.push(std::move(item)); }
+			std::optional<T> tryPop() { return queue.tryPop(); }
+			std::optional<T> waitAndPop() { return queue.waitAndPop(); }
+			void close() { queue.close(); }
+			bool isClosed() const { return queue.isClosed(); }
+
+		private:
+			SpscRingQueue<T> queue;
+		};
+	};
+}
+
+#endif //__QUEUE_POLICIES_H_INCLUDED__
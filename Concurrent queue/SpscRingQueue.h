@@ -0,0 +1,71 @@
+#ifndef __SPSC_RING_QUEUE_H_INCLUDED__
+#define __SPSC_RING_QUEUE_H_INCLUDED__
+
+#include "Lock-free data structures\Queue\Queue\EventCount.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace IDragnev::Multithreading
+{
+	//A bounded ring for exactly one producer and one consumer thread.
+	//Each side owns its index and keeps a cached copy of the other one,
+	//so it reads the other side's cache line only when the ring looks
+	//full (or empty). Both sides can sleep on an EventCount.
+	template <typename T>
+	class SpscRingQueue
+	{
+	private:
+		static_assert(std::is_nothrow_move_constructible_v<T>,
+			          "SpscRingQueue requires T to be nothrow move-constructible");
+
+		static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+		using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+	public:
+		static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+		//the capacity is rounded up to a power of two
+		explicit SpscRingQueue(std::size_t capacity = DEFAULT_CAPACITY);
+		SpscRingQueue(const SpscRingQueue&) = delete;
+		~SpscRingQueue();
+
+		SpscRingQueue& operator=(const SpscRingQueue&) = delete;
+
+		//waits while the ring is full, returns false if it is closed
+		bool push(T item);
+		bool tryPush(T&& item);
+		std::optional<T> tryPop();
+		//returns std::nullopt once the ring is closed and drained
+		std::optional<T> waitAndPop();
+
+		void close() noexcept;
+		bool isClosed() const noexcept { return closed.load(); }
+
+	private:
+		bool isFull() noexcept;
+		T* slotAt(std::size_t index) noexcept;
+
+		static std::size_t roundUpToPowerOfTwo(std::size_t n) noexcept;
+
+	private:
+		const std::size_t mask;
+		std::unique_ptr<Slot[]> slots;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head = 0;
+		std::size_t cachedTail = 0;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail = 0;
+		std::size_t cachedHead = 0;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<bool> closed = false;
+		EventCount itemsAvailable;
+		EventCount spaceAvailable;
+	};
+}
+
+#include "SpscRingQueueImpl.hpp"
+#endif //__SPSC_RING_QUEUE_H_INCLUDED__
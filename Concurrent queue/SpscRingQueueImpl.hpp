@@ -0,0 +1,157 @@
+#include <new>
+#include <utility>
+
+namespace IDragnev::Multithreading
+{
+	template <typename T>
+	SpscRingQueue<T>::SpscRingQueue(std::size_t capacity) :
+		mask(roundUpToPowerOfTwo(capacity) - 1),
+		slots(std::make_unique<Slot[]>(mask + 1))
+	{
+	}
+
+	template <typename T>
+	std::size_t SpscRingQueue<T>::roundUpToPowerOfTwo(std::size_t n) noexcept
+	{
+		auto result = std::size_t{ 1 };
+		while (result < n)
+		{
+			result *= 2;
+		}
+
+		return result;
+	}
+
+	template <typename T>
+	SpscRingQueue<T>::~SpscRingQueue()
+	{
+		for (auto i = head.load(); i != tail.load(); ++i)
+		{
+			slotAt(i)->~T();
+		}
+	}
+
+	template <typename T>
+	inline T* SpscRingQueue<T>::slotAt(std::size_t index) noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(&slots[index & mask]));
+	}
+
+	template <typename T>
+	bool SpscRingQueue<T>::push(T item)
+	{
+		for (;;)
+		{
+			if (isClosed())
+			{
+				return false;
+			}
+			else if (tryPush(std::move(item)))
+			{
+				return true;
+			}
+
+			auto key = spaceAvailable.prepareWait();
+			if (!isFull() || isClosed())
+			{
+				spaceAvailable.cancelWait();
+			}
+			else
+			{
+				spaceAvailable.wait(key);
+			}
+		}
+	}
+
+	//the item is moved from only if there is room for it
+	template <typename T>
+	bool SpscRingQueue<T>::tryPush(T&& item)
+	{
+		if (isFull())
+		{
+			return false;
+		}
+
+		auto index = tail.load(std::memory_order_relaxed);
+		::new (&slots[index & mask]) T(std::move(item));
+		tail.store(index + 1, std::memory_order_release);
+
+		itemsAvailable.notifyOne();
+
+		return true;
+	}
+
+	template <typename T>
+	bool SpscRingQueue<T>::isFull() noexcept
+	{
+		auto index = tail.load(std::memory_order_relaxed);
+
+		if (index - cachedHead > mask)
+		{
+			cachedHead = head.load(std::memory_order_acquire);
+		}
+
+		return index - cachedHead > mask;
+	}
+
+	template <typename T>
+	std::optional<T> SpscRingQueue<T>::tryPop()
+	{
+		auto index = head.load(std::memory_order_relaxed);
+
+		if (index == cachedTail)
+		{
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (index == cachedTail)
+			{
+				return std::nullopt;
+			}
+		}
+
+		auto slot = slotAt(index);
+		auto result = std::optional<T>{ std::move(*slot) };
+		slot->~T();
+		head.store(index + 1, std::memory_order_release);
+
+		spaceAvailable.notifyOne();
+
+		return result;
+	}
+
+	template <typename T>
+	std::optional<T> SpscRingQueue<T>::waitAndPop()
+	{
+		for (;;)
+		{
+			if (auto result = tryPop();
+				result != std::nullopt)
+			{
+				return result;
+			}
+
+			auto key = itemsAvailable.prepareWait();
+			if (auto result = tryPop();
+				result != std::nullopt)
+			{
+				itemsAvailable.cancelWait();
+				return result;
+			}
+			else if (isClosed())
+			{
+				//items pushed before the closing may have been missed above
+				itemsAvailable.cancelWait();
+				return tryPop();
+			}
+
+			itemsAvailable.wait(key);
+		}
+	}
+
+	template <typename T>
+	void SpscRingQueue<T>::close() noexcept
+	{
+		closed.store(true);
+		itemsAvailable.notifyAll();
+		spaceAvailable.notifyAll();
+	}
+}
@@ -0,0 +1,39 @@
+#include "ConcurrentQueue.h"
+#include "SmartThread.h"
+#include <iostream>
+
+using namespace IDragnev::Multithreading;
+
+template <typename Policy>
+void sumThroughQueueWith()
+{
+	auto queue = ConcurrentQueue<unsigned, Policy>{};
+	auto sum = 0ull;
+
+	{
+		auto consumer = SmartThread{ std::thread{ [&queue, &sum]
+		{
+			while (auto item = queue.waitAndPop())
+			{
+				sum += *item;
+			}
+		} } };
+
+		for (auto i = 1u; i <= 1000u; ++i)
+		{
+			queue.push(i);
+		}
+
+		queue.close();
+	}
+
+	std::cout << Policy::name << ": " << sum << "\n";
+}
+
+int main()
+{
+	sumThroughQueueWith<SingleLock>();
+	sumThroughQueueWith<TwoLock>();
+	sumThroughQueueWith<LockFreeMpmc>();
+	sumThroughQueueWith<Spsc>();
+}
@@ -39,7 +39,7 @@ void workOn(TaskQueue& queue)
 	Task task;
 	do
 	{
-		task = queue.waitAndExtractFront();
+		task = *queue.waitAndExtractFront();
 	} while (!isTheLastTask(task));
 }
 
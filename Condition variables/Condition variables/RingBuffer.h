@@ -0,0 +1,63 @@
+#ifndef __RING_BUFFER_H_INCLUDED__
+#define __RING_BUFFER_H_INCLUDED__
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+
+namespace IDragnev
+{
+	namespace Threads
+	{
+		//A growable FIFO of contiguous storage. The capacity is a power of
+		//two and doubles when the buffer is full, so a steady stream of
+		//items does not allocate once the buffer has reached its working size.
+		template <typename T>
+		class RingBuffer
+		{
+		private:
+			static_assert(std::is_nothrow_move_constructible_v<T> || std::is_nothrow_copy_constructible_v<T>,
+				          "RingBuffer cannot relocate its items safely unless T is nothrow move- or copy-constructible");
+
+			using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+			static constexpr std::size_t INITIAL_CAPACITY = 16;
+
+		public:
+			RingBuffer() = default;
+			RingBuffer(std::initializer_list<T> source);
+			RingBuffer(const RingBuffer& source);
+			RingBuffer(RingBuffer&& source) noexcept;
+			~RingBuffer();
+
+			RingBuffer& operator=(RingBuffer rhs) noexcept;
+
+			template <typename... Args>
+			void emplaceBack(Args&&... args);
+			void pushBack(T&& item);
+			void pushBack(const T& item);
+			T popFront();
+			T& front() noexcept;
+
+			bool isEmpty() const noexcept { return size == 0; }
+			std::size_t getSize() const noexcept { return size; }
+
+			void swap(RingBuffer& other) noexcept;
+
+		private:
+			void growIfFull();
+			void clear() noexcept;
+			T* slotAt(std::size_t position) const noexcept;
+
+		private:
+			std::unique_ptr<Slot[]> slots = nullptr;
+			std::size_t capacity = 0;
+			std::size_t first = 0;
+			std::size_t size = 0;
+		};
+	}
+}
+
+#include "RingBufferImpl.hpp"
+#endif //__RING_BUFFER_H_INCLUDED__
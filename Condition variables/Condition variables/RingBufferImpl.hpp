@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace IDragnev
+{
+	namespace Threads
+	{
+		template <typename T>
+		RingBuffer<T>::RingBuffer(std::initializer_list<T> source)
+		{
+			for (const auto& item : source)
+			{
+				pushBack(item);
+			}
+		}
+
+		template <typename T>
+		RingBuffer<T>::RingBuffer(const RingBuffer& source)
+		{
+			for (auto i = std::size_t{ 0 }; i < source.size; ++i)
+			{
+				pushBack(*source.slotAt(i));
+			}
+		}
+
+		template <typename T>
+		RingBuffer<T>::RingBuffer(RingBuffer&& source) noexcept
+		{
+			swap(source);
+		}
+
+		template <typename T>
+		RingBuffer<T>::~RingBuffer()
+		{
+			clear();
+		}
+
+		template <typename T>
+		auto RingBuffer<T>::operator=(RingBuffer rhs) noexcept -> RingBuffer&
+		{
+			swap(rhs);
+			return *this;
+		}
+
+		template <typename T>
+		void RingBuffer<T>::swap(RingBuffer& other) noexcept
+		{
+			using std::swap;
+
+			swap(slots, other.slots);
+			swap(capacity, other.capacity);
+			swap(first, other.first);
+			swap(size, other.size);
+		}
+
+		template <typename T>
+		template <typename... Args>
+		void RingBuffer<T>::emplaceBack(Args&&... args)
+		{
+			growIfFull();
+			::new (slotAt(size)) T(std::forward<Args>(args)...);
+			++size;
+		}
+
+		template <typename T>
+		inline void RingBuffer<T>::pushBack(T&& item)
+		{
+			emplaceBack(std::move(item));
+		}
+
+		template <typename T>
+		inline void RingBuffer<T>::pushBack(const T& item)
+		{
+			emplaceBack(item);
+		}
+
+		template <typename T>
+		T RingBuffer<T>::popFront()
+		{
+			auto slot = slotAt(0);
+			auto result = std::move_if_noexcept(*slot);
+			slot->~T();
+
+			first = (first + 1) & (capacity - 1);
+			--size;
+
+			return result;
+		}
+
+		template <typename T>
+		inline T& RingBuffer<T>::front() noexcept
+		{
+			return *slotAt(0);
+		}
+
+		template <typename T>
+		inline T* RingBuffer<T>::slotAt(std::size_t position) const noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(&slots[(first + position) & (capacity - 1)]));
+		}
+
+		//the items are moved to the start of the new storage
+		template <typename T>
+		void RingBuffer<T>::growIfFull()
+		{
+			if (size < capacity)
+			{
+				return;
+			}
+
+			auto newCapacity = std::max(capacity * 2, INITIAL_CAPACITY);
+			auto newSlots = std::make_unique<Slot[]>(newCapacity);
+
+			for (auto i = std::size_t{ 0 }; i < size; ++i)
+			{
+				auto slot = slotAt(i);
+				::new (&newSlots[i]) T(std::move_if_noexcept(*slot));
+				slot->~T();
+			}
+
+			slots = std::move(newSlots);
+			capacity = newCapacity;
+			first = 0;
+		}
+
+		template <typename T>
+		void RingBuffer<T>::clear() noexcept
+		{
+			for (auto i = std::size_t{ 0 }; i < size; ++i)
+			{
+				slotAt(i)->~T();
+			}
+
+			first = 0;
+			size = 0;
+		}
+	}
+}
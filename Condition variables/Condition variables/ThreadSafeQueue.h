@@ -1,10 +1,14 @@
 #ifndef __THREAD_SAFE_QUEUE_H_INCLUDED__
 #define __THREAD_SAFE_QUEUE_H_INCLUDED__
 
-#include <queue>
+#include "RingBuffer.h"
 #include <mutex>
 #include <condition_variable>
 #include <type_traits>
+#include <optional>
+#include <vector>
+#include <algorithm>
+#include <assert.h>
 
 namespace IDragnev
 {
@@ -25,7 +29,7 @@ namespace IDragnev
 
 			static_assert(IsTypeRequirementSatisfied::value);
 
-			using Queue = std::queue<T>;
+			using Queue = RingBuffer<T>;
 			using LockGuard = std::lock_guard<std::mutex>;
 			using UniqueLock = std::unique_lock<std::mutex>;
 
@@ -37,22 +41,38 @@ namespace IDragnev
 
 			ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
 
-			T waitAndExtractFront();
-			void insertBack(T value);
+			//returns std::nullopt once the queue is closed and drained
+			std::optional<T> waitAndExtractFront();
+			std::optional<T> tryToExtractFront();
+			//waits for at least one item and takes up to count of them,
+			//returns no items once the queue is closed and drained;
+			//count must be positive, or no items would mean nothing
+			std::vector<T> waitAndExtractUpTo(std::size_t count);
+			//return false if the queue is closed
+			bool insertBack(T value);
+			template <typename InputIterator>
+			bool insertBatch(InputIterator first, InputIterator last);
 			bool isEmpty() const;
 
+			//wakes all waiting consumers
+			void close();
+			bool isClosed() const;
+
 		private:
 			static Queue copyQueueOf(const ThreadSafeQueue& other);
+			T extractFront();
+			void notifyConsumersOf(std::size_t inserted);
 
-			auto queueIsNotEmpty() const noexcept
+			auto queueIsNotEmptyOrClosed() const noexcept
 			{
-				return [this] { return !queue.empty(); };
+				return [this] { return !queue.isEmpty() || closed; };
 			}
 
 		private:
 			mutable std::mutex mutex;
 			std::condition_variable condition;
 			Queue queue;
+			bool closed = false;
 		};
 	}
 }
@@ -23,30 +23,130 @@ namespace IDragnev
 		}
 
 		template <typename T>
-		T ThreadSafeQueue<T>::waitAndExtractFront()
+		std::optional<T> ThreadSafeQueue<T>::waitAndExtractFront()
 		{
 			auto lock = UniqueLock(mutex);
-			condition.wait(lock, queueIsNotEmpty());
+			condition.wait(lock, queueIsNotEmptyOrClosed());
 
-			auto result = std::move(queue.front());
-			queue.pop();
+			return !queue.isEmpty() ? std::optional<T>{ extractFront() } : std::nullopt;
+		}
+
+		template <typename T>
+		std::optional<T> ThreadSafeQueue<T>::tryToExtractFront()
+		{
+			auto lock = LockGuard(mutex);
+			return !queue.isEmpty() ? std::optional<T>{ extractFront() } : std::nullopt;
+		}
+
+		template <typename T>
+		std::vector<T> ThreadSafeQueue<T>::waitAndExtractUpTo(std::size_t count)
+		{
+			assert(count > 0);
+			auto result = std::vector<T>{};
+
+			auto lock = UniqueLock(mutex);
+			condition.wait(lock, queueIsNotEmptyOrClosed());
+
+			result.reserve(std::min(count, queue.getSize()));
+			while (result.size() < count && !queue.isEmpty())
+			{
+				result.push_back(extractFront());
+			}
 
 			return result;
 		}
 
 		template <typename T>
-		void ThreadSafeQueue<T>::insertBack(T value)
+		inline T ThreadSafeQueue<T>::extractFront()
 		{
-			auto lock = LockGuard(mutex);
-			queue.push(std::move(value));
+			//assumes the mutex is locked!
+			return queue.popFront();
+		}
+
+		//the notification is sent after unlocking, so that
+		//the woken consumer does not block on the mutex right away
+		template <typename T>
+		bool ThreadSafeQueue<T>::insertBack(T value)
+		{
+			{
+				auto lock = LockGuard(mutex);
+				if (closed)
+				{
+					return false;
+				}
+
+				queue.pushBack(std::move(value));
+			}
+
 			condition.notify_one();
+
+			return true;
+		}
+
+		template <typename T>
+		template <typename InputIterator>
+		bool ThreadSafeQueue<T>::insertBatch(InputIterator first, InputIterator last)
+		{
+			auto inserted = std::size_t{ 0 };
+
+			try
+			{
+				auto lock = LockGuard(mutex);
+				if (closed)
+				{
+					return false;
+				}
+
+				for (; first != last; ++first, ++inserted)
+				{
+					queue.pushBack(*first);
+				}
+			}
+			catch (...)
+			{
+				//the items inserted before the failure stay in the queue
+				notifyConsumersOf(inserted);
+				throw;
+			}
+
+			notifyConsumersOf(inserted);
+
+			return true;
+		}
+
+		template <typename T>
+		void ThreadSafeQueue<T>::notifyConsumersOf(std::size_t inserted)
+		{
+			if (inserted == 1)
+			{
+				condition.notify_one();
+			}
+			else if (inserted > 1)
+			{
+				condition.notify_all();
+			}
+		}
+
+		template <typename T>
+		void ThreadSafeQueue<T>::close()
+		{
+			auto lock = LockGuard(mutex);
+			closed = true;
+			condition.notify_all();
+		}
+
+		template <typename T>
+		bool ThreadSafeQueue<T>::isClosed() const
+		{
+			auto lock = LockGuard(mutex);
+			return closed;
 		}
 
 		template <typename T>
 		bool ThreadSafeQueue<T>::isEmpty() const
 		{
 			auto lock = LockGuard(mutex);
-			return queue.empty();
+			return queue.isEmpty();
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+namespace IDragnev::Multithreading
+{
+	template <typename T, typename Storage>
+	ThreadSafeQueue<T, Storage>::Batch::Batch(NodePtr first, std::size_t size) noexcept :
+		first(std::move(first)),
+		size(size)
+	{
+	}
+
+	template <typename T, typename Storage>
+	ThreadSafeQueue<T, Storage>::Batch::Batch(Batch&& source) noexcept :
+		first(std::move(source.first)),
+		size(std::exchange(source.size, 0))
+	{
+	}
+
+	template <typename T, typename Storage>
+	ThreadSafeQueue<T, Storage>::Batch::~Batch()
+	{
+		clear();
+	}
+
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::Batch::operator=(Batch&& rhs) noexcept -> Batch&
+	{
+		if (this != &rhs)
+		{
+			clear();
+			first = std::move(rhs.first);
+			size = std::exchange(rhs.size, 0);
+		}
+
+		return *this;
+	}
+
+	//one node at a time, a long chain would overflow
+	//the stack if its nodes destroyed each other recursively
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::Batch::clear() noexcept
+	{
+		while (first != nullptr)
+		{
+			first = std::move(first->next);
+		}
+
+		size = 0;
+	}
+}
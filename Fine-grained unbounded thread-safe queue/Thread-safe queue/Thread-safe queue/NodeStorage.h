@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Lock-free data structures\Object pool\Object pool\FixedBlockPool.h"
+#include <memory>
+#include <new>
+#include <optional>
+
+//Storage policies of ThreadSafeQueue. A policy decides how an item is kept
+//in a node (and so what extraction returns) and where the nodes come from.
+namespace IDragnev::Multithreading
+{
+	//every item and every node is a separate heap allocation,
+	//extraction returns std::unique_ptr<T>
+	struct HeapStorage
+	{
+		template <typename T>
+		using Data = std::unique_ptr<T>;
+
+		template <typename T>
+		static Data<T> makeData(T&& item)
+		{
+			return std::make_unique<T>(std::move(item));
+		}
+
+		template <typename Node>
+		class Allocator
+		{
+		public:
+			using Deleter = std::default_delete<Node>;
+
+			std::unique_ptr<Node, Deleter> makeNode()
+			{
+				return std::make_unique<Node>();
+			}
+		};
+	};
+
+	//items live inside the nodes, which are recycled through
+	//a FixedBlockPool owned by the queue, extraction returns std::optional<T>;
+	//once the pool has warmed up, inserting and extracting do not allocate
+	struct InlineStorage
+	{
+		template <typename T>
+		using Data = std::optional<T>;
+
+		template <typename T>
+		static Data<T> makeData(T&& item)
+		{
+			return Data<T>{ std::move(item) };
+		}
+
+		template <typename Node>
+		class Allocator
+		{
+		public:
+			class Deleter
+			{
+			public:
+				Deleter(FixedBlockPool* pool = nullptr) noexcept : pool(pool) { }
+
+				void operator()(Node* node) const noexcept
+				{
+					node->~Node();
+					pool->deallocate(node);
+				}
+
+			private:
+				FixedBlockPool* pool;
+			};
+
+			static_assert(alignof(Node) <= FixedBlockPool::getAlignment(),
+				          "InlineStorage does not support over-aligned items");
+
+			Allocator() :
+				pool(sizeof(Node))
+			{
+			}
+
+			std::unique_ptr<Node, Deleter> makeNode()
+			{
+				auto block = pool.allocate();
+				return { ::new (block) Node{}, Deleter{ &pool } };
+			}
+
+		private:
+			FixedBlockPool pool;
+		};
+	};
+}
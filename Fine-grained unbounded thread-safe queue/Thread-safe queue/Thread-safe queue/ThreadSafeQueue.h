@@ -1,56 +1,173 @@
 #pragma once
 
+#include "NodeStorage.h"
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <iterator>
+#include <utility>
 #include <condition_variable>
 #include <assert.h>
 
 namespace IDragnev::Multithreading
 {
-	template <typename T>
+	//A queue with separate locks for the head and the tail.
+	//Given a capacity, producers block (or fail) while it is full.
+	//Each side counts its sleeping threads, so the other side only
+	//takes the opposite lock to notify when somebody is waiting.
+	//Once closed, inserts fail and consumers drain what is left,
+	//after which waitAndExtractFront returns an empty result (end of stream).
+	//Storage decides how items are kept and extracted, see NodeStorage.h.
+	template <typename T, typename Storage = HeapStorage>
 	class ThreadSafeQueue
 	{
 	private:
+		struct Node;
+
+		using NodeAllocator = typename Storage::template Allocator<Node>;
+		using NodePtr = std::unique_ptr<Node, typename NodeAllocator::Deleter>;
+		using Data = typename Storage::template Data<T>;
+
 		struct Node
 		{
-			std::unique_ptr<T> data = nullptr;
-			std::unique_ptr<Node> next = nullptr;
+			Data data{};
+			NodePtr next = nullptr;
 		};
 
 		using LockGuard = std::lock_guard<std::mutex>;
 		using UniqueLock = std::unique_lock<std::mutex>;
 
 	public:
+		static constexpr std::size_t UNBOUNDED = std::numeric_limits<std::size_t>::max();
+
+		//std::unique_ptr<T> or std::optional<T>, empty if there was no item
+		using Extracted = Data;
+
+		//Items detached from the front of the queue at once, front first.
+		//A batch must not outlive its queue.
+		class Batch
+		{
+		public:
+			class Iterator
+			{
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = T;
+				using difference_type = std::ptrdiff_t;
+				using pointer = T*;
+				using reference = T&;
+
+				explicit Iterator(Node* node = nullptr) noexcept : node(node) { }
+
+				T& operator*() const noexcept { return *node->data; }
+				T* operator->() const noexcept { return &*node->data; }
+				Iterator& operator++() noexcept { node = node->next.get(); return *this; }
+				Iterator operator++(int) noexcept { auto copy = *this; ++(*this); return copy; }
+
+				bool operator==(const Iterator& rhs) const noexcept { return node == rhs.node; }
+				bool operator!=(const Iterator& rhs) const noexcept { return node != rhs.node; }
+
+			private:
+				Node* node;
+			};
+
+			Batch() = default;
+			Batch(Batch&& source) noexcept;
+			Batch(const Batch&) = delete;
+			~Batch();
+
+			Batch& operator=(Batch&& rhs) noexcept;
+			Batch& operator=(const Batch&) = delete;
+
+			Iterator begin() const noexcept { return Iterator{ first.get() }; }
+			Iterator end() const noexcept { return Iterator{}; }
+			bool isEmpty() const noexcept { return size == 0; }
+			std::size_t getSize() const noexcept { return size; }
+
+		private:
+			friend class ThreadSafeQueue;
+
+			Batch(NodePtr first, std::size_t size) noexcept;
+			void clear() noexcept;
+
+		private:
+			NodePtr first = nullptr;
+			std::size_t size = 0;
+		};
+
 		ThreadSafeQueue();
+		explicit ThreadSafeQueue(std::size_t capacity);
 		~ThreadSafeQueue() = default;
 
 		ThreadSafeQueue(const ThreadSafeQueue&) = delete;
 		ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
 
-		std::unique_ptr<T> tryToExtractFront();
-		std::unique_ptr<T> waitAndExtractFront();
-		void insertBack(T item);
+		Extracted tryToExtractFront();
+		Extracted waitAndExtractFront();
+		//take the front items under a single lock of the head
+		Batch extractAll();
+		Batch extractUpTo(std::size_t count);
+
+		//block while the queue is full, return false if it is closed
+		bool insertBack(T item);
+		bool waitAndInsertBack(T item);
+		//the item is left untouched if it could not be inserted
+		bool tryInsertBack(T&& item);
+		template <typename Rep, typename Period>
+		bool tryInsertBack(T&& item, const std::chrono::duration<Rep, Period>& timeout);
+		template <typename Rep, typename Period>
+		bool waitAndInsertBack(T&& item, const std::chrono::duration<Rep, Period>& timeout);
 
 		bool isEmpty();
 		void tryToClear() noexcept;
 
+		//wakes all waiting producers and consumers
+		void close();
+		void reopen();
+		bool isClosed() const noexcept { return closed.load(); }
+
+		std::size_t getCapacity() const noexcept { return capacity; }
+
 	private:
-		static auto makeDummyNode();
+		NodePtr makeDummyNode();
 
 		Node* getTail();
-		void updateTail(std::unique_ptr<T>&& data, std::unique_ptr<Node>&& dummy);
-		std::unique_ptr<Node> extractHead();
+		void updateTail(Data&& data, NodePtr&& dummy);
+		NodePtr extractHead();
+		NodePtr tryToExtractHead();
+		Batch detachUpTo(std::size_t count);
+
+		template <typename Callable>
+		bool insertBackWaitingWith(T&& item, Callable waitWhileFull);
+		void waitWhileFull(UniqueLock& lock);
+		template <typename Rep, typename Period>
+		bool waitWhileFull(UniqueLock& lock, const std::chrono::duration<Rep, Period>& timeout);
+		bool isFull() const noexcept;
 
 		UniqueLock waitWhileEmpty();
 		bool checkIsEmpty();
 
+		void notifyConsumer();
+		void notifyProducer();
+		void notifyProducers();
+
 	private:
-		std::unique_ptr<Node> head;
+		NodeAllocator nodes;
+		NodePtr head;
 		Node* tail;
 		std::mutex headMutex;
 		std::mutex tailMutex;
-		std::condition_variable condition;
+		std::condition_variable notEmpty;
+		std::condition_variable notFull;
+		const std::size_t capacity;
+		std::atomic<std::size_t> size = 0;
+		std::atomic<std::size_t> waitingConsumers = 0;
+		std::atomic<std::size_t> waitingProducers = 0;
+		std::atomic<bool> closed = false;
 	};
 }
 
+#include "BatchImpl.hpp"
 #include "ThreadSafeQueueImpl.hpp"
\ No newline at end of file
@@ -1,108 +1,338 @@
-
 namespace IDragnev::Multithreading
 {
-	template <typename T>
-	ThreadSafeQueue<T>::ThreadSafeQueue() :
+	template <typename T, typename Storage>
+	ThreadSafeQueue<T, Storage>::ThreadSafeQueue() :
+		ThreadSafeQueue(UNBOUNDED)
+	{
+	}
+
+	template <typename T, typename Storage>
+	ThreadSafeQueue<T, Storage>::ThreadSafeQueue(std::size_t capacity) :
 		head(makeDummyNode()),
-		tail(head.get())
+		tail(head.get()),
+		capacity(capacity > 0 ? capacity : 1)
 	{
 	}
 
-	template <typename T>
-	inline auto ThreadSafeQueue<T>::makeDummyNode()
+	template <typename T, typename Storage>
+	inline auto ThreadSafeQueue<T, Storage>::makeDummyNode() -> NodePtr
 	{
-		return std::make_unique<Node>();
+		return nodes.makeNode();
 	}
 
-	template <typename T>
-	void ThreadSafeQueue<T>::insertBack(T item)
+	template <typename T, typename Storage>
+	bool ThreadSafeQueue<T, Storage>::insertBack(T item)
 	{
-		auto data = std::make_unique<T>(std::move(item));
+		auto data = Storage::makeData(std::move(item));
 		auto dummy = makeDummyNode();
 
-		updateTail(std::move(data), std::move(dummy));
+		{
+			auto lock = UniqueLock(tailMutex);
+			if (isFull())
+			{
+				waitWhileFull(lock);
+			}
+
+			if (isClosed())
+			{
+				return false;
+			}
 
-		condition.notify_one();
+			updateTail(std::move(data), std::move(dummy));
+		}
+
+		notifyConsumer();
+
+		return true;
 	}
 
-	template <typename T>
-	void ThreadSafeQueue<T>::updateTail(std::unique_ptr<T>&& data, std::unique_ptr<Node>&& dummy)
+	template <typename T, typename Storage>
+	inline bool ThreadSafeQueue<T, Storage>::waitAndInsertBack(T item)
 	{
-		auto lock = LockGuard(tailMutex);
+		return insertBack(std::move(item));
+	}
+
+	template <typename T, typename Storage>
+	bool ThreadSafeQueue<T, Storage>::tryInsertBack(T&& item)
+	{
+		return insertBackWaitingWith(std::move(item), [](auto&) { return false; });
+	}
+
+	template <typename T, typename Storage>
+	template <typename Rep, typename Period>
+	inline bool ThreadSafeQueue<T, Storage>::tryInsertBack(T&& item, const std::chrono::duration<Rep, Period>& timeout)
+	{
+		return waitAndInsertBack(std::move(item), timeout);
+	}
+
+	template <typename T, typename Storage>
+	template <typename Rep, typename Period>
+	bool ThreadSafeQueue<T, Storage>::waitAndInsertBack(T&& item, const std::chrono::duration<Rep, Period>& timeout)
+	{
+		return insertBackWaitingWith(std::move(item), [this, &timeout](auto& lock)
+		{
+			return waitWhileFull(lock, timeout);
+		});
+	}
+
+	//the item is moved from only once there is room for it
+	template <typename T, typename Storage>
+	template <typename Callable>
+	bool ThreadSafeQueue<T, Storage>::insertBackWaitingWith(T&& item, Callable waitWhileFull)
+	{
+		auto dummy = makeDummyNode();
+
+		{
+			auto lock = UniqueLock(tailMutex);
+			if (auto hasRoom = !isFull() || waitWhileFull(lock);
+				!hasRoom || isClosed())
+			{
+				return false;
+			}
+
+			updateTail(Storage::makeData(std::move(item)), std::move(dummy));
+		}
+
+		notifyConsumer();
 
+		return true;
+	}
+
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::updateTail(Data&& data, NodePtr&& dummy)
+	{
+		//assumes tailMutex is locked!
 		auto newTail = dummy.get();
 		tail->data = std::move(data);
 		tail->next = std::move(dummy);
 		tail = newTail;
+		size.fetch_add(1);
 	}
 
-	template <typename T>
-	std::unique_ptr<T> ThreadSafeQueue<T>::tryToExtractFront()
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::waitWhileFull(UniqueLock& lock)
+	{
+		waitingProducers.fetch_add(1);
+		notFull.wait(lock, [this] { return !isFull() || isClosed(); });
+		waitingProducers.fetch_sub(1);
+	}
+
+	template <typename T, typename Storage>
+	template <typename Rep, typename Period>
+	bool ThreadSafeQueue<T, Storage>::waitWhileFull(UniqueLock& lock, const std::chrono::duration<Rep, Period>& timeout)
+	{
+		waitingProducers.fetch_add(1);
+		auto hasRoom = notFull.wait_for(lock, timeout, [this] { return !isFull() || isClosed(); });
+		waitingProducers.fetch_sub(1);
+
+		return hasRoom;
+	}
+
+	template <typename T, typename Storage>
+	inline bool ThreadSafeQueue<T, Storage>::isFull() const noexcept
+	{
+		return size.load() >= capacity;
+	}
+
+	//A sleeping thread checks its condition while holding the lock of its side
+	//and releases it only when it is already waiting. Registering as a waiter
+	//before the check and changing the size before reading the waiters
+	//(all sequentially consistent) guarantees that either the waiter sees
+	//the change or the notifier sees the waiter. Taking the waiter's lock
+	//before notifying makes sure the notification does not come too early.
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::notifyConsumer()
+	{
+		if (waitingConsumers.load() > 0)
+		{
+			auto lock = LockGuard(headMutex);
+			notEmpty.notify_one();
+		}
+	}
+
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::notifyProducer()
+	{
+		if (waitingProducers.load() > 0)
+		{
+			auto lock = LockGuard(tailMutex);
+			notFull.notify_one();
+		}
+	}
+
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::notifyProducers()
+	{
+		if (waitingProducers.load() > 0)
+		{
+			auto lock = LockGuard(tailMutex);
+			notFull.notify_all();
+		}
+	}
+
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::tryToExtractFront() -> Extracted
+	{
+		if (auto oldHead = tryToExtractHead();
+			oldHead != nullptr)
+		{
+			notifyProducer();
+			return std::move(oldHead->data);
+		}
+
+		return {};
+	}
+
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::tryToExtractHead() -> NodePtr
 	{
 		auto lock = LockGuard(headMutex);
+		return !checkIsEmpty() ? extractHead() : nullptr;
+	}
+
+	template <typename T, typename Storage>
+	inline auto ThreadSafeQueue<T, Storage>::extractAll() -> Batch
+	{
+		return extractUpTo(UNBOUNDED);
+	}
+
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::extractUpTo(std::size_t count) -> Batch
+	{
+		auto batch = [this, count]
+		{
+			auto lock = LockGuard(headMutex);
+			return detachUpTo(count);
+		}();
+
+		if (!batch.isEmpty())
+		{
+			notifyProducers();
+		}
 
-		return !checkIsEmpty() ? std::move(extractHead()->data) : nullptr;
+		return batch;
 	}
 
-	template <typename T>
-	inline bool ThreadSafeQueue<T>::checkIsEmpty()
+	//the tail is read once, so the whole batch costs
+	//one lock of the head and one of the tail
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::detachUpTo(std::size_t count) -> Batch
+	{
+		//assumes headMutex is locked!
+		auto end = getTail();
+		if (count == 0 || head.get() == end)
+		{
+			return {};
+		}
+
+		auto last = head.get();
+		auto detached = std::size_t{ 1 };
+		for (; detached < count && last->next.get() != end; ++detached)
+		{
+			last = last->next.get();
+		}
+
+		auto first = std::move(head);
+		head = std::move(last->next);
+		size.fetch_sub(detached);
+
+		return Batch{ std::move(first), detached };
+	}
+
+	template <typename T, typename Storage>
+	inline bool ThreadSafeQueue<T, Storage>::checkIsEmpty()
 	{
 		//assumes headMutex is locked!
 		return head.get() == getTail();
 	}
 
-	template <typename T>
-	auto ThreadSafeQueue<T>::getTail() -> Node*
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::getTail() -> Node*
 	{
 		auto lock = LockGuard(tailMutex);
 		return tail;
 	}
 
-	template <typename T>
-	auto ThreadSafeQueue<T>::extractHead() -> std::unique_ptr<Node>
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::extractHead() -> NodePtr
 	{
+		//assumes headMutex is locked!
 		auto oldHead = std::move(head);
 		head = std::move(oldHead->next);
+		size.fetch_sub(1);
 
 		return oldHead;
 	}
 
-	template <typename T>
-	std::unique_ptr<T> ThreadSafeQueue<T>::waitAndExtractFront()
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::waitAndExtractFront() -> Extracted
 	{
-		auto lock = waitWhileEmpty();
-		auto oldHead = extractHead();
+		auto oldHead = [this]
+		{
+			auto lock = waitWhileEmpty();
+			return !checkIsEmpty() ? extractHead() : nullptr;
+		}();
+
+		if (oldHead == nullptr)
+		{
+			return {};
+		}
+
+		notifyProducer();
 
 		return std::move(oldHead->data);
 	}
 
-	template <typename T>
-	auto ThreadSafeQueue<T>::waitWhileEmpty() -> UniqueLock
+	template <typename T, typename Storage>
+	auto ThreadSafeQueue<T, Storage>::waitWhileEmpty() -> UniqueLock
 	{
 		auto lock = UniqueLock(headMutex);
-		condition.wait(lock, [this] { return !checkIsEmpty(); });
+
+		waitingConsumers.fetch_add(1);
+		notEmpty.wait(lock, [this] { return !checkIsEmpty() || isClosed(); });
+		waitingConsumers.fetch_sub(1);
 
 		return std::move(lock);
 	}
 
-	template <typename T>
-	bool ThreadSafeQueue<T>::isEmpty()
+	template <typename T, typename Storage>
+	bool ThreadSafeQueue<T, Storage>::isEmpty()
 	{
 		auto lock = LockGuard(headMutex);
 		return checkIsEmpty();
 	}
 
-	template <typename T>
-	void ThreadSafeQueue<T>::tryToClear() noexcept
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::tryToClear() noexcept
 	{
 		auto lock = std::scoped_lock(headMutex, tailMutex);
 		try
 		{
 			head = makeDummyNode();
 			tail = head.get();
+			size.store(0);
+			notFull.notify_all();
 		}
 		catch (std::bad_alloc&)
 		{
 		}
 	}
-}
\ No newline at end of file
+
+	//the flag changes under both locks, so a waiter is either
+	//about to check it or already waiting for the notification
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::close()
+	{
+		auto lock = std::scoped_lock(headMutex, tailMutex);
+		closed.store(true);
+		notEmpty.notify_all();
+		notFull.notify_all();
+	}
+
+	template <typename T, typename Storage>
+	void ThreadSafeQueue<T, Storage>::reopen()
+	{
+		auto lock = std::scoped_lock(headMutex, tailMutex);
+		closed.store(false);
+	}
+}
@@ -0,0 +1,109 @@
+#ifndef __BACKOFF_H_INCLUDED__
+#define __BACKOFF_H_INCLUDED__
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+//Backoff policies for the CAS retry loops of the lock-free containers.
+//A loop creates a fresh policy object per operation and calls it
+//after every failed CAS:
+//    for (auto backoff = Backoff{}; !cas(); backoff()) { }
+namespace IDragnev::Multithreading
+{
+	//tells the core that it is spinning, so that it stops speculating
+	//ahead and leaves the pipeline to a sibling hyper-thread
+	inline void cpuRelax() noexcept
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) || defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		asm volatile("yield");
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+	//retries right away
+	class NoBackoff
+	{
+	public:
+		static constexpr auto name = "no backoff";
+
+		void operator()() noexcept { }
+	};
+
+	//pauses for twice as long after every failure;
+	//once the limit is reached the thread yields instead
+	template <std::uint32_t MIN_SPINS = 4, std::uint32_t MAX_SPINS = 1024>
+	class ExponentialBackoff
+	{
+	public:
+		static constexpr auto name = "exponential backoff";
+
+		void operator()() noexcept
+		{
+			if (spins < MAX_SPINS)
+			{
+				for (auto i = std::uint32_t{ 0 }; i < spins; ++i)
+				{
+					cpuRelax();
+				}
+
+				spins *= 2;
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+	private:
+		std::uint32_t spins = MIN_SPINS;
+	};
+
+	//pauses for a random number of spins in a window which doubles
+	//after every failure up to a limit, so that threads which failed
+	//together do not retry together
+	template <std::uint32_t MAX_SPINS = 1024>
+	class TruncatedRandomBackoff
+	{
+	public:
+		static constexpr auto name = "random backoff";
+
+		void operator()() noexcept
+		{
+			auto spins = nextRandom() % window + 1;
+			for (auto i = std::uint32_t{ 0 }; i < spins; ++i)
+			{
+				cpuRelax();
+			}
+
+			window = std::min(window * 2, MAX_SPINS);
+		}
+
+	private:
+		static std::uint32_t nextRandom() noexcept
+		{
+			//xorshift, seeded differently in every thread
+			static thread_local auto state = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state)) | 1u;
+
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+
+			return state;
+		}
+
+	private:
+		std::uint32_t window = 2;
+	};
+}
+
+#endif //__BACKOFF_H_INCLUDED__
@@ -0,0 +1,27 @@
+#include "Affinity.h"
+#include <thread>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	void pinCurrentThreadTo(std::size_t cpu)
+	{
+		cpu %= std::max(std::thread::hardware_concurrency(), 1u);
+
+#ifdef _WIN32
+		SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << cpu);
+#else
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+	}
+}
@@ -0,0 +1,12 @@
+#ifndef __AFFINITY_H_INCLUDED__
+#define __AFFINITY_H_INCLUDED__
+
+#include <cstddef>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	//cpu is taken modulo the number of hardware threads
+	void pinCurrentThreadTo(std::size_t cpu);
+}
+
+#endif //__AFFINITY_H_INCLUDED__
@@ -0,0 +1,83 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<long> allocations = 0;
+
+	void* allocate(std::size_t size)
+	{
+		if (auto block = std::malloc(size != 0 ? size : 1);
+			block != nullptr)
+		{
+			allocations.fetch_add(1, std::memory_order_relaxed);
+			return block;
+		}
+
+		throw std::bad_alloc{};
+	}
+
+	void* allocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		auto align = static_cast<std::size_t>(alignment);
+		auto roundedSize = (size + align - 1) / align * align;
+#ifdef _WIN32
+		auto block = _aligned_malloc(roundedSize != 0 ? roundedSize : align, align);
+#else
+		auto block = std::aligned_alloc(align, roundedSize != 0 ? roundedSize : align);
+#endif
+		if (block != nullptr)
+		{
+			allocations.fetch_add(1, std::memory_order_relaxed);
+			return block;
+		}
+
+		throw std::bad_alloc{};
+	}
+
+	void release(void* block) noexcept
+	{
+		if (block != nullptr)
+		{
+			allocations.fetch_sub(1, std::memory_order_relaxed);
+			std::free(block);
+		}
+	}
+
+	void releaseAligned(void* block) noexcept
+	{
+		if (block != nullptr)
+		{
+			allocations.fetch_sub(1, std::memory_order_relaxed);
+#ifdef _WIN32
+			_aligned_free(block);
+#else
+			std::free(block);
+#endif
+		}
+	}
+}
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	long liveAllocations() noexcept
+	{
+		return allocations.load();
+	}
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void operator delete(void* block) noexcept { release(block); }
+void operator delete[](void* block) noexcept { release(block); }
+void operator delete(void* block, std::size_t) noexcept { release(block); }
+void operator delete[](void* block, std::size_t) noexcept { release(block); }
+void operator delete(void* block, std::align_val_t) noexcept { releaseAligned(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { releaseAligned(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { releaseAligned(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { releaseAligned(block); }
@@ -0,0 +1,12 @@
+#ifndef __ALLOCATION_COUNTER_H_INCLUDED__
+#define __ALLOCATION_COUNTER_H_INCLUDED__
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	//The number of blocks obtained through the global operator new
+	//and not yet released. The counting operators are defined in
+	//AllocationCounter.cpp and replace the default ones program-wide.
+	long liveAllocations() noexcept;
+}
+
+#endif //__ALLOCATION_COUNTER_H_INCLUDED__
@@ -0,0 +1,34 @@
+#ifndef __BENCHMARK_H_INCLUDED__
+#define __BENCHMARK_H_INCLUDED__
+
+#include "Workload.h"
+#include "Statistics.h"
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	struct Measurement
+	{
+		bool stalled = false;
+		double seconds = 0;
+		double itemsPerSecond = 0;
+		LatencySummary push;
+		LatencySummary pop;
+	};
+
+	template <typename Container>
+	Measurement measure(const Configuration& configuration)
+	{
+		auto result = Workload<Container>{ configuration, false }();
+
+		auto measurement = Measurement{};
+		measurement.stalled = result.stalled;
+		measurement.seconds = result.seconds;
+		measurement.itemsPerSecond = !result.stalled ? configuration.items / result.seconds : 0.0;
+		measurement.push = summarize(std::move(result.pushLatencies));
+		measurement.pop = summarize(std::move(result.popLatencies));
+
+		return measurement;
+	}
+}
+
+#endif //__BENCHMARK_H_INCLUDED__
@@ -0,0 +1,17 @@
+#ifndef __BENCHMARK_CONFIGURATION_H_INCLUDED__
+#define __BENCHMARK_CONFIGURATION_H_INCLUDED__
+
+#include <cstddef>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	struct Configuration
+	{
+		std::size_t producers = 1;
+		std::size_t consumers = 1;
+		std::size_t items = 1 << 18;
+		bool pinned = false;
+	};
+}
+
+#endif //__BENCHMARK_CONFIGURATION_H_INCLUDED__
@@ -0,0 +1,251 @@
+#ifndef __CONTAINER_ADAPTERS_H_INCLUDED__
+#define __CONTAINER_ADAPTERS_H_INCLUDED__
+
+#include "Lock-free data structures\Stack\Stack\LockFreeStack.h"
+#include "Lock-free data structures\Stack\Stack\EliminationBackoffStack.h"
+#include "Lock-free data structures\Queue\Queue\LockFreeQueue.h"
+#include "Condition variables\Condition variables\ThreadSafeQueue.h"
+#include "Fine-grained unbounded thread-safe queue\Thread-safe queue\Thread-safe queue\ThreadSafeQueue.h"
+#include "Thread pool\WorkStealableQueue.h"
+#include "Concurrent queue\ConcurrentQueue.h"
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//Every container is driven through the same two operations:
+//    void push(T item);
+//    std::optional<T> pop();
+//pop returns std::nullopt when the container is empty, unless
+//isBlocking is true, in which case it waits for an item.
+//Containers with isSingleProducerSingleConsumer set are only run
+//with one producer and one consumer.
+namespace IDragnev::Multithreading::Benchmarking
+{
+	template <typename T, typename Backoff = NoBackoff>
+	class LockFreeStackAdapter
+	{
+	public:
+		inline static const auto name = std::string{ "LockFreeStack (" } + Backoff::name + ")";
+		static constexpr bool isBlocking = false;
+		using Item = T;
+
+		void push(T item) { stack.push(std::move(item)); }
+		std::optional<T> pop() { return stack.pop(); }
+
+	private:
+		LockFreeStack<T, Backoff> stack;
+	};
+
+	//mixes the batch operations in: every other push goes through a chain
+	//and every BATCH_PERIOD-th pop detaches the whole stack, keeps the top
+	//item and pushes the rest back, racing with the plain pops
+	template <typename T, typename Backoff = NoBackoff>
+	class BatchingStackAdapter
+	{
+	private:
+		using Stack = LockFreeStack<T, Backoff>;
+		static constexpr std::size_t BATCH_PERIOD = 16;
+
+	public:
+		inline static const auto name = std::string{ "LockFreeStack batches (" } + Backoff::name + ")";
+		static constexpr bool isBlocking = false;
+		using Item = T;
+
+		void push(T item)
+		{
+			thread_local auto pushes = std::size_t{ 0 };
+
+			if (++pushes % 2 != 0)
+			{
+				stack.push(std::move(item));
+				return;
+			}
+
+			auto chain = typename Stack::Chain{};
+			chain.push(std::move(item));
+			stack.pushChain(std::move(chain));
+		}
+
+		std::optional<T> pop()
+		{
+			thread_local auto pops = std::size_t{ 0 };
+
+			if (++pops % BATCH_PERIOD != 0)
+			{
+				return stack.pop();
+			}
+
+			auto batch = stack.popAll();
+			if (batch.isEmpty())
+			{
+				return std::nullopt;
+			}
+
+			auto it = batch.begin();
+			auto result = std::optional<T>{ std::move(*it) };
+			auto rest = typename Stack::Chain{};
+
+			for (++it; it != batch.end(); ++it)
+			{
+				rest.push(std::move(*it));
+			}
+
+			stack.pushChain(std::move(rest));
+			return result;
+		}
+
+	private:
+		Stack stack;
+	};
+
+	template <typename T>
+	class EliminationBackoffStackAdapter
+	{
+	public:
+		static constexpr auto name = "EliminationBackoffStack";
+		static constexpr bool isBlocking = false;
+		using Item = T;
+
+		void push(T item) { stack.push(std::move(item)); }
+		std::optional<T> pop() { return stack.pop(); }
+
+	private:
+		EliminationBackoffStack<T> stack;
+	};
+
+	template <typename T, typename Backoff = NoBackoff>
+	class LockFreeQueueAdapter
+	{
+	public:
+		inline static const auto name = std::string{ "LockFreeQueue (" } + Backoff::name + ")";
+		static constexpr bool isBlocking = false;
+		using Item = T;
+
+		void push(T item) { queue.enqueue(std::move(item)); }
+		std::optional<T> pop()
+		{
+			auto result = queue.extractFront();
+			return result != nullptr ? std::optional<T>{ std::move(*result) } : std::nullopt;
+		}
+
+	private:
+		LockFreeQueue<T, Backoff> queue;
+	};
+
+	template <typename T>
+	class SingleLockQueueAdapter
+	{
+	public:
+		static constexpr auto name = "ThreadSafeQueue (single lock)";
+		static constexpr bool isBlocking = true;
+		using Item = T;
+
+		void push(T item) { queue.insertBack(std::move(item)); }
+		std::optional<T> pop() { return queue.waitAndExtractFront(); }
+
+	private:
+		IDragnev::Threads::ThreadSafeQueue<T> queue;
+	};
+
+	template <typename T>
+	class TwoLockQueueAdapter
+	{
+	public:
+		static constexpr auto name = "ThreadSafeQueue (two locks)";
+		static constexpr bool isBlocking = false;
+		using Item = T;
+
+		void push(T item) { queue.insertBack(std::move(item)); }
+		std::optional<T> pop()
+		{
+			auto result = queue.tryToExtractFront();
+			return result != nullptr ? std::optional<T>{ std::move(*result) } : std::nullopt;
+		}
+
+	private:
+		ThreadSafeQueue<T> queue;
+	};
+
+	template <typename T>
+	class InlineTwoLockQueueAdapter
+	{
+	public:
+		static constexpr auto name = "ThreadSafeQueue (two locks, inline)";
+		static constexpr bool isBlocking = false;
+		using Item = T;
+
+		void push(T item) { queue.insertBack(std::move(item)); }
+		std::optional<T> pop() { return queue.tryToExtractFront(); }
+
+	private:
+		ThreadSafeQueue<T, InlineStorage> queue;
+	};
+
+	//WorkStealableQueue only stores Function objects, so every item
+	//travels inside a task which hands it back when invoked
+	template <typename T>
+	class WorkStealableQueueAdapter
+	{
+	public:
+		static constexpr auto name = "WorkStealableQueue";
+		static constexpr bool isBlocking = false;
+		using Item = T;
+
+		void push(T item)
+		{
+			queue.insertFront([item = std::move(item)]() mutable { extracted = std::move(item); });
+		}
+
+		std::optional<T> pop()
+		{
+			if (auto task = queue.extractBack();
+				task != std::nullopt)
+			{
+				(*task)();
+				return std::exchange(extracted, std::nullopt);
+			}
+
+			return std::nullopt;
+		}
+
+	private:
+		WorkStealableQueue queue;
+
+		inline static thread_local std::optional<T> extracted;
+	};
+
+	template <typename T, typename Policy>
+	class ConcurrentQueueAdapter
+	{
+	public:
+		inline static const auto name = std::string{ "ConcurrentQueue (" } + Policy::name + ")";
+		static constexpr bool isBlocking = false;
+		static constexpr bool isSingleProducerSingleConsumer = std::is_same_v<Policy, Spsc>;
+		using Item = T;
+
+		void push(T item) { queue.push(std::move(item)); }
+		std::optional<T> pop() { return queue.tryPop(); }
+
+	private:
+		ConcurrentQueue<T, Policy> queue;
+	};
+
+	//binds the backoff policy of an adapter, so that it can be listed
+	//among the adapters which only take the item type
+	template <template <typename, typename> typename Adapter, typename Backoff>
+	struct WithBackoff
+	{
+		template <typename T>
+		using Type = Adapter<T, Backoff>;
+	};
+
+	template <typename Policy>
+	struct WithPolicy
+	{
+		template <typename T>
+		using Type = ConcurrentQueueAdapter<T, Policy>;
+	};
+}
+
+#endif //__CONTAINER_ADAPTERS_H_INCLUDED__
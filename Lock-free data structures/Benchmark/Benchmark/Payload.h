@@ -0,0 +1,54 @@
+#ifndef __BENCHMARK_PAYLOAD_H_INCLUDED__
+#define __BENCHMARK_PAYLOAD_H_INCLUDED__
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	//An item of exactly Size bytes which counts its live instances,
+	//so that a container leaking or double-destroying items is detected.
+	template <std::size_t Size>
+	class Payload
+	{
+	private:
+		static_assert(Size >= sizeof(std::uint64_t), "A payload must be able to hold its id");
+
+		using Padding = std::array<unsigned char, Size - sizeof(std::uint64_t)>;
+
+	public:
+		static constexpr std::size_t size = Size;
+
+		Payload() noexcept : Payload(0) { }
+		explicit Payload(std::uint64_t id) noexcept :
+			id(id)
+		{
+			live.fetch_add(1, std::memory_order_relaxed);
+		}
+		Payload(const Payload& source) noexcept :
+			id(source.id),
+			padding(source.padding)
+		{
+			live.fetch_add(1, std::memory_order_relaxed);
+		}
+		~Payload()
+		{
+			live.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		Payload& operator=(const Payload& rhs) = default;
+
+		std::uint64_t getId() const noexcept { return id; }
+
+		static long liveInstances() noexcept { return live.load(); }
+
+	private:
+		std::uint64_t id;
+		Padding padding{};
+
+		inline static std::atomic<long> live = 0;
+	};
+}
+
+#endif //__BENCHMARK_PAYLOAD_H_INCLUDED__
@@ -0,0 +1,22 @@
+#include "Statistics.h"
+#include <algorithm>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	LatencySummary summarize(std::vector<std::uint64_t> samples)
+	{
+		if (samples.empty())
+		{
+			return {};
+		}
+
+		std::sort(samples.begin(), samples.end());
+		auto percentile = [&samples](double p)
+		{
+			auto index = static_cast<std::size_t>(p * (samples.size() - 1));
+			return samples[index];
+		};
+
+		return { percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), samples.back() };
+	}
+}
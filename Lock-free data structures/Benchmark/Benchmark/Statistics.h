@@ -0,0 +1,22 @@
+#ifndef __STATISTICS_H_INCLUDED__
+#define __STATISTICS_H_INCLUDED__
+
+#include <cstdint>
+#include <vector>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	//all values are in nanoseconds
+	struct LatencySummary
+	{
+		std::uint64_t p50 = 0;
+		std::uint64_t p90 = 0;
+		std::uint64_t p99 = 0;
+		std::uint64_t p999 = 0;
+		std::uint64_t max = 0;
+	};
+
+	LatencySummary summarize(std::vector<std::uint64_t> samples);
+}
+
+#endif //__STATISTICS_H_INCLUDED__
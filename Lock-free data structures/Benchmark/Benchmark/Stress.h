@@ -0,0 +1,121 @@
+#ifndef __STRESS_H_INCLUDED__
+#define __STRESS_H_INCLUDED__
+
+#include "Workload.h"
+#include "AllocationCounter.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	struct StressReport
+	{
+		std::size_t rounds = 0;
+		std::uint64_t items = 0;
+		std::uint64_t lost = 0;
+		std::uint64_t duplicated = 0;
+		std::size_t stalledRounds = 0;
+		long leakedItems = 0;
+		long leakedAllocations = 0;
+
+		bool passed() const noexcept
+		{
+			return lost == 0 && duplicated == 0 && stalledRounds == 0 &&
+				   leakedItems == 0 && leakedAllocations == 0;
+		}
+	};
+
+	//Repeats rounds of the workload until duration has passed, checking
+	//after each round that every produced item was consumed exactly once
+	//and that the container released all of its items and memory.
+	template <typename Container>
+	class Stress
+	{
+	private:
+		using Clock = std::chrono::steady_clock;
+		using Item = typename Container::Item;
+		using Result = typename Workload<Container>::Result;
+
+	public:
+		StressReport operator()(const Configuration& configuration, Clock::duration duration);
+
+	private:
+		void runRound(const Configuration& configuration);
+		void verify(const Configuration& configuration, const Result& result);
+
+	private:
+		StressReport report;
+	};
+
+	template <typename Container>
+	StressReport Stress<Container>::operator()(const Configuration& configuration, Clock::duration duration)
+	{
+		report = {};
+		const auto deadline = Clock::now() + duration;
+
+		//an unchecked first round lets the container set up per-thread state
+		//which outlives it by design, such as the caches of a FixedBlockPool
+		(*std::make_unique<Workload<Container>>(configuration, true))();
+
+		do
+		{
+			runRound(configuration);
+		} while (Clock::now() < deadline);
+
+		return report;
+	}
+
+	template <typename Container>
+	void Stress<Container>::runRound(const Configuration& configuration)
+	{
+		const auto itemsBefore = Item::liveInstances();
+		const auto allocationsBefore = liveAllocations();
+		{
+			auto workload = std::make_unique<Workload<Container>>(configuration, true);
+			auto result = (*workload)();
+			workload.reset();
+
+			verify(configuration, result);
+		}
+		report.leakedItems += Item::liveInstances() - itemsBefore;
+		report.leakedAllocations += liveAllocations() - allocationsBefore;
+		report.items += configuration.items;
+		++report.rounds;
+	}
+
+	template <typename Container>
+	void Stress<Container>::verify(const Configuration& configuration, const Result& result)
+	{
+		using W = Workload<Container>;
+
+		auto seen = std::vector<std::vector<bool>>(configuration.producers);
+		for (std::size_t i = 0; i < configuration.producers; ++i)
+		{
+			auto share = configuration.items / configuration.producers;
+			seen[i].resize(i < configuration.items % configuration.producers ? share + 1 : share);
+		}
+
+		auto unique = std::uint64_t{ 0 };
+		for (auto id : result.consumedIds)
+		{
+			auto producer = id >> W::SEQUENCE_BITS;
+			auto sequenceNumber = id & W::SEQUENCE_MASK;
+
+			if (producer >= seen.size() || sequenceNumber >= seen[producer].size() || seen[producer][sequenceNumber])
+			{
+				++report.duplicated;
+			}
+			else
+			{
+				seen[producer][sequenceNumber] = true;
+				++unique;
+			}
+		}
+
+		report.lost += configuration.items - unique;
+		report.stalledRounds += result.stalled ? 1 : 0;
+	}
+}
+
+#endif //__STRESS_H_INCLUDED__
@@ -0,0 +1,90 @@
+#ifndef __WORKLOAD_H_INCLUDED__
+#define __WORKLOAD_H_INCLUDED__
+
+#include "Configuration.h"
+#include "SmartThread.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	//Runs one round of producers and consumers over a fresh Container.
+	//Every item carries a unique id: the producer's index in the top bits
+	//and the producer's sequence number in the rest.
+	//A round in which the consumers stop making progress after all items
+	//were produced is abandoned and reported as stalled.
+	template <typename Container>
+	class Workload
+	{
+	private:
+		using Item = typename Container::Item;
+		using Clock = std::chrono::steady_clock;
+		using Samples = std::vector<std::uint64_t>;
+		using Threads = std::vector<SmartThread>;
+
+		struct ThreadRecord
+		{
+			Samples latencies;
+			std::vector<std::uint64_t> ids;
+		};
+
+	public:
+		struct Result
+		{
+			bool stalled = false;
+			double seconds = 0;
+			Samples pushLatencies;
+			Samples popLatencies;
+			std::vector<std::uint64_t> consumedIds;
+		};
+
+		static constexpr std::uint64_t SEQUENCE_BITS = 40;
+		static constexpr std::uint64_t SEQUENCE_MASK = (std::uint64_t{ 1 } << SEQUENCE_BITS) - 1;
+
+		Workload(const Configuration& configuration, bool recordIds);
+		Workload(const Workload&) = delete;
+		~Workload() = default;
+
+		Workload& operator=(const Workload&) = delete;
+
+		Result operator()();
+
+	private:
+		void launchThreads(Threads& threads);
+		void waitForCompletion();
+		void abandon();
+		void produce(std::size_t producer);
+		void consume(std::size_t consumer);
+		void waitForStart(std::size_t cpu);
+		void releaseBlockedConsumers(std::size_t count);
+		std::size_t itemsOf(std::size_t producer) const noexcept;
+		Result collectResult();
+
+		static std::uint64_t makeId(std::size_t producer, std::size_t sequenceNumber) noexcept;
+		static bool isPoison(const Item& item) noexcept;
+		static std::uint64_t nanosecondsSince(Clock::time_point start) noexcept;
+
+		static constexpr std::uint64_t POISON_ID = ~std::uint64_t{ 0 };
+		static constexpr std::size_t SAMPLING_PERIOD = 64;
+		static constexpr auto STALL_TIMEOUT = std::chrono::seconds(5);
+
+	private:
+		Configuration configuration;
+		bool recordIds;
+		Container container;
+		std::vector<ThreadRecord> producerRecords;
+		std::vector<ThreadRecord> consumerRecords;
+		std::atomic<std::size_t> readyThreads = 0;
+		std::atomic<bool> go = false;
+		std::atomic<std::size_t> consumed = 0;
+		std::atomic<std::size_t> finishedProducers = 0;
+		std::atomic<bool> stalled = false;
+		Clock::time_point start;
+		Clock::time_point finish;
+	};
+}
+
+#include "WorkloadImpl.hpp"
+#endif //__WORKLOAD_H_INCLUDED__
@@ -0,0 +1,230 @@
+#include "Affinity.h"
+#include <thread>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	template <typename Container>
+	Workload<Container>::Workload(const Configuration& configuration, bool recordIds) :
+		configuration(configuration),
+		recordIds(recordIds),
+		producerRecords(configuration.producers),
+		consumerRecords(configuration.consumers)
+	{
+	}
+
+	template <typename Container>
+	auto Workload<Container>::operator()() -> Result
+	{
+		{
+			auto threads = Threads{};
+			launchThreads(threads);
+
+			const auto total = configuration.producers + configuration.consumers;
+			while (readyThreads.load() < total)
+			{
+				std::this_thread::yield();
+			}
+
+			start = Clock::now();
+			go.store(true);
+
+			waitForCompletion();
+		}
+
+		return collectResult();
+	}
+
+	template <typename Container>
+	void Workload<Container>::waitForCompletion()
+	{
+		using namespace std::chrono_literals;
+
+		auto lastConsumed = consumed.load();
+		auto lastProgress = Clock::now();
+
+		while (lastConsumed < configuration.items)
+		{
+			std::this_thread::sleep_for(1ms);
+
+			if (auto current = consumed.load();
+				current != lastConsumed || finishedProducers.load() < configuration.producers)
+			{
+				lastConsumed = current;
+				lastProgress = Clock::now();
+			}
+			else if (Clock::now() - lastProgress > STALL_TIMEOUT)
+			{
+				abandon();
+				break;
+			}
+		}
+	}
+
+	template <typename Container>
+	void Workload<Container>::abandon()
+	{
+		stalled.store(true);
+		releaseBlockedConsumers(configuration.consumers);
+	}
+
+	template <typename Container>
+	void Workload<Container>::launchThreads(Threads& threads)
+	{
+		threads.reserve(configuration.producers + configuration.consumers);
+
+		for (std::size_t i = 0; i < configuration.consumers; ++i)
+		{
+			threads.emplace_back(std::thread{ [this, i] { consume(i); } });
+		}
+		for (std::size_t i = 0; i < configuration.producers; ++i)
+		{
+			threads.emplace_back(std::thread{ [this, i] { produce(i); } });
+		}
+	}
+
+	template <typename Container>
+	void Workload<Container>::waitForStart(std::size_t cpu)
+	{
+		if (configuration.pinned)
+		{
+			pinCurrentThreadTo(cpu);
+		}
+
+		readyThreads.fetch_add(1);
+		while (!go.load())
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	template <typename Container>
+	void Workload<Container>::produce(std::size_t producer)
+	{
+		auto& record = producerRecords[producer];
+		const auto count = itemsOf(producer);
+		record.latencies.reserve(count / SAMPLING_PERIOD + 1);
+
+		waitForStart(configuration.consumers + producer);
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto item = Item{ makeId(producer, i) };
+
+			if (i % SAMPLING_PERIOD == 0)
+			{
+				auto start = Clock::now();
+				container.push(std::move(item));
+				record.latencies.push_back(nanosecondsSince(start));
+			}
+			else
+			{
+				container.push(std::move(item));
+			}
+		}
+
+		finishedProducers.fetch_add(1);
+	}
+
+	template <typename Container>
+	inline std::size_t Workload<Container>::itemsOf(std::size_t producer) const noexcept
+	{
+		auto share = configuration.items / configuration.producers;
+		return producer < configuration.items % configuration.producers ? share + 1 : share;
+	}
+
+	template <typename Container>
+	void Workload<Container>::consume(std::size_t consumer)
+	{
+		auto& record = consumerRecords[consumer];
+		if (recordIds)
+		{
+			record.ids.reserve(configuration.items / configuration.consumers + 1);
+		}
+		record.latencies.reserve(configuration.items / configuration.consumers / SAMPLING_PERIOD + 1);
+
+		waitForStart(consumer);
+
+		for (std::size_t i = 0;
+			 consumed.load(std::memory_order_relaxed) < configuration.items && !stalled.load(std::memory_order_relaxed);
+			 ++i)
+		{
+			auto start = Clock::now();
+			auto item = container.pop();
+
+			if (!item)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+			else if (isPoison(*item))
+			{
+				break;
+			}
+
+			if (i % SAMPLING_PERIOD == 0)
+			{
+				record.latencies.push_back(nanosecondsSince(start));
+			}
+			if (recordIds)
+			{
+				record.ids.push_back(item->getId());
+			}
+			if (consumed.fetch_add(1) + 1 == configuration.items)
+			{
+				finish = Clock::now();
+				releaseBlockedConsumers(configuration.consumers - 1);
+			}
+		}
+	}
+
+	template <typename Container>
+	void Workload<Container>::releaseBlockedConsumers(std::size_t count)
+	{
+		if constexpr (Container::isBlocking)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				container.push(Item{ POISON_ID });
+			}
+		}
+	}
+
+	template <typename Container>
+	auto Workload<Container>::collectResult() -> Result
+	{
+		auto result = Result{};
+		result.stalled = stalled.load();
+		result.seconds = !result.stalled ? std::chrono::duration<double>(finish - start).count() : 0.0;
+
+		for (auto& record : producerRecords)
+		{
+			result.pushLatencies.insert(result.pushLatencies.end(), record.latencies.begin(), record.latencies.end());
+		}
+		for (auto& record : consumerRecords)
+		{
+			result.popLatencies.insert(result.popLatencies.end(), record.latencies.begin(), record.latencies.end());
+			result.consumedIds.insert(result.consumedIds.end(), record.ids.begin(), record.ids.end());
+		}
+
+		return result;
+	}
+
+	template <typename Container>
+	inline std::uint64_t Workload<Container>::makeId(std::size_t producer, std::size_t sequenceNumber) noexcept
+	{
+		return (std::uint64_t{ producer } << SEQUENCE_BITS) | sequenceNumber;
+	}
+
+	template <typename Container>
+	inline bool Workload<Container>::isPoison(const Item& item) noexcept
+	{
+		return item.getId() == POISON_ID;
+	}
+
+	template <typename Container>
+	inline std::uint64_t Workload<Container>::nanosecondsSince(Clock::time_point start) noexcept
+	{
+		using std::chrono::nanoseconds;
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<nanoseconds>(Clock::now() - start).count());
+	}
+}
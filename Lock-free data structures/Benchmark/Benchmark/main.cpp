@@ -0,0 +1,223 @@
+#include "ContainerAdapters.h"
+#include "Payload.h"
+#include "Benchmark.h"
+#include "Stress.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace IDragnev::Multithreading::Benchmarking;
+using namespace std::chrono_literals;
+
+template <template <typename> typename... Adapters>
+struct Containers { };
+
+template <std::size_t... Sizes>
+struct Payloads { };
+
+template <typename T>
+struct Type { using type = T; };
+
+using IDragnev::Multithreading::NoBackoff;
+using IDragnev::Multithreading::ExponentialBackoff;
+using IDragnev::Multithreading::TruncatedRandomBackoff;
+
+using AllContainers = Containers<WithBackoff<LockFreeStackAdapter, NoBackoff>::Type,
+	                             WithBackoff<LockFreeStackAdapter, ExponentialBackoff<>>::Type,
+	                             WithBackoff<LockFreeStackAdapter, TruncatedRandomBackoff<>>::Type,
+	                             WithBackoff<BatchingStackAdapter, NoBackoff>::Type,
+	                             EliminationBackoffStackAdapter,
+	                             WithBackoff<LockFreeQueueAdapter, NoBackoff>::Type,
+	                             WithBackoff<LockFreeQueueAdapter, ExponentialBackoff<>>::Type,
+	                             WithBackoff<LockFreeQueueAdapter, TruncatedRandomBackoff<>>::Type,
+	                             SingleLockQueueAdapter,
+	                             TwoLockQueueAdapter,
+	                             InlineTwoLockQueueAdapter,
+	                             WithPolicy<IDragnev::Multithreading::SingleLock>::Type,
+	                             WithPolicy<IDragnev::Multithreading::TwoLock>::Type,
+	                             WithPolicy<IDragnev::Multithreading::LockFreeMpmc>::Type,
+	                             WithPolicy<IDragnev::Multithreading::Spsc>::Type,
+	                             WorkStealableQueueAdapter>;
+using AllPayloads = Payloads<8, 64, 256>;
+
+struct Options
+{
+	std::string mode = "bench";
+	std::size_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	std::size_t items = 1 << 18;
+	std::size_t seconds = 10;
+	std::string only;
+};
+
+Options parse(int argc, char* argv[])
+{
+	auto options = Options{};
+
+	for (auto i = 1; i < argc; ++i)
+	{
+		auto argument = std::string{ argv[i] };
+		auto hasValue = i + 1 < argc;
+
+		if (argument == "--threads" && hasValue)      { options.maxThreads = std::stoul(argv[++i]); }
+		else if (argument == "--items" && hasValue)   { options.items = std::stoul(argv[++i]); }
+		else if (argument == "--seconds" && hasValue) { options.seconds = std::stoul(argv[++i]); }
+		else if (argument == "--only" && hasValue)    { options.only = argv[++i]; }
+		else                                          { options.mode = argument; }
+	}
+
+	return options;
+}
+
+template <typename Container, typename = void>
+struct IsSingleProducerSingleConsumer : std::false_type { };
+
+template <typename Container>
+struct IsSingleProducerSingleConsumer<Container, std::void_t<decltype(Container::isSingleProducerSingleConsumer)>> :
+	std::bool_constant<Container::isSingleProducerSingleConsumer>
+{
+};
+
+template <typename Container>
+bool canRun(const Configuration& configuration)
+{
+	return !IsSingleProducerSingleConsumer<Container>::value ||
+		   (configuration.producers == 1 && configuration.consumers == 1);
+}
+
+auto threadCounts(std::size_t max)
+{
+	auto result = std::vector<std::size_t>{};
+
+	for (std::size_t count = 1; count < max; count *= 2)
+	{
+		result.push_back(count);
+	}
+	result.push_back(max);
+
+	return result;
+}
+
+void print(const LatencySummary& latency)
+{
+	std::cout << std::setw(8) << latency.p50
+		      << std::setw(8) << latency.p99
+		      << std::setw(9) << latency.p999 << " |";
+}
+
+template <typename Container>
+void benchmark(const Options& options)
+{
+	for (auto pinned : { false, true })
+	{
+		for (auto producers : threadCounts(options.maxThreads))
+		{
+			for (auto consumers : threadCounts(options.maxThreads))
+			{
+				auto configuration = Configuration{ producers, consumers, options.items, pinned };
+				if (!canRun<Container>(configuration))
+				{
+					continue;
+				}
+
+				auto result = measure<Container>(configuration);
+
+				std::cout << std::left << std::setw(38) << Container::name << std::right
+					      << std::setw(6) << Container::Item::size
+					      << std::setw(4) << producers << std::setw(4) << consumers
+					      << std::setw(8) << (pinned ? "pinned" : "free") << " |";
+				if (result.stalled)
+				{
+					std::cout << " stalled\n";
+					continue;
+				}
+				std::cout << std::fixed << std::setprecision(3) << std::setw(9) << result.itemsPerSecond / 1e6 << " |";
+				print(result.push);
+				print(result.pop);
+				std::cout << "\n";
+			}
+		}
+	}
+}
+
+template <typename Container>
+void stress(const Options& options)
+{
+	auto many = std::max(options.maxThreads / 2, std::size_t{ 1 });
+	auto shapes = { Configuration{ 1, 1, options.items },
+		            Configuration{ many, many, options.items },
+		            Configuration{ 1, many, options.items },
+		            Configuration{ many, 1, options.items } };
+
+	for (const auto& configuration : shapes)
+	{
+		if (!canRun<Container>(configuration))
+		{
+			continue;
+		}
+
+		auto report = Stress<Container>{}(configuration, std::chrono::seconds(options.seconds));
+
+		std::cout << std::left << std::setw(38) << Container::name << std::right
+			      << std::setw(6) << Container::Item::size
+			      << std::setw(4) << configuration.producers << std::setw(4) << configuration.consumers
+			      << " | rounds " << report.rounds << ", items " << report.items
+			      << ", lost " << report.lost << ", duplicated " << report.duplicated
+			      << ", stalled " << report.stalledRounds
+			      << ", leaked items " << report.leakedItems
+			      << ", leaked allocations " << report.leakedAllocations
+			      << (report.passed() ? "  OK\n" : "  FAILED\n");
+	}
+}
+
+template <template <typename> typename... Adapters, std::size_t... Sizes, typename Callable>
+void forEachCombination(Containers<Adapters...>, Payloads<Sizes...>, const std::string& only, Callable f)
+{
+	auto isSelected = [&only](auto container)
+	{
+		using Container = typename decltype(container)::type;
+		return std::string_view{ Container::name }.find(only) != std::string_view::npos;
+	};
+	auto callIfSelected = [&](auto container)
+	{
+		if (isSelected(container))
+		{
+			f(container);
+		}
+	};
+	auto forEachAdapterOf = [&callIfSelected](auto payload)
+	{
+		using Item = typename decltype(payload)::type;
+		(callIfSelected(Type<Adapters<Item>>{}), ...);
+	};
+
+	(forEachAdapterOf(Type<Payload<Sizes>>{}), ...);
+}
+
+int main(int argc, char* argv[])
+{
+	auto options = parse(argc, argv);
+
+	if (options.mode == "bench")
+	{
+		std::cout << "container                            payload   P   C  threads |   Mops/s |"
+			      << " push p50     p99    p99.9 |  pop p50     p99    p99.9 |  (ns)\n";
+		forEachCombination(AllContainers{}, AllPayloads{}, options.only, [&options](auto container)
+		{
+			benchmark<typename decltype(container)::type>(options);
+		});
+	}
+	else if (options.mode == "stress")
+	{
+		forEachCombination(AllContainers{}, AllPayloads{}, options.only, [&options](auto container)
+		{
+			stress<typename decltype(container)::type>(options);
+		});
+	}
+	else
+	{
+		std::cerr << "usage: Benchmark [bench|stress] [--threads N] [--items N] [--seconds N] [--only NAME]\n";
+		return 1;
+	}
+}
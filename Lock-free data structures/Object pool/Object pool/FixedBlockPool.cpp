@@ -0,0 +1,327 @@
+#include "FixedBlockPool.h"
+#include "TaggedFreeList.h"
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace IDragnev::Multithreading
+{
+	namespace
+	{
+		struct Magazine
+		{
+			bool isEmpty() const noexcept
+			{
+				return count == 0;
+			}
+
+			void push(FreeBlock* block) noexcept
+			{
+				block->next = top;
+				top = block;
+				++count;
+			}
+
+			FreeBlock* pop() noexcept
+			{
+				auto block = top;
+				top = top->next;
+				--count;
+
+				return block;
+			}
+
+			//detaches the top n blocks as a chain and returns its first block
+			FreeBlock* detachChain(std::size_t n) noexcept
+			{
+				auto first = top;
+				auto last = first;
+				for (auto i = std::size_t{ 1 }; i < n; ++i)
+				{
+					last = last->next;
+				}
+
+				top = last->next;
+				count -= n;
+				last->next = nullptr;
+				first->count = n;
+
+				return first;
+			}
+
+			FreeBlock* top = nullptr;
+			std::size_t count = 0;
+		};
+
+		std::size_t roundUp(std::size_t size, std::size_t alignment) noexcept
+		{
+			return (size + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	struct FixedBlockPool::State
+	{
+		State(std::size_t blockSize, std::size_t blocksPerChunk);
+
+		void refill(Magazine& magazine);
+		void spill(Magazine& magazine) noexcept;
+		void giveBack(Magazine& magazine) noexcept;
+		void grow(Magazine& magazine);
+		FreeBlock* makeChain(std::byte* chunk, std::size_t begin, std::size_t end) const noexcept;
+
+		static std::uint64_t nextId() noexcept;
+
+		const std::uint64_t id;
+		const std::size_t blockSize;
+		const std::size_t blocksPerChunk;
+		TaggedFreeList depot;
+		std::mutex chunksMutex;
+		std::vector<std::unique_ptr<std::byte[]>> chunks;
+	};
+
+	namespace
+	{
+		//The magazines one thread holds, one per pool it has used.
+		//Pools are told apart by id rather than by address,
+		//as a new pool may reuse the address of a destroyed one.
+		class ThreadCache
+		{
+		private:
+			using State = FixedBlockPool::State;
+
+			struct Entry
+			{
+				std::uint64_t poolId;
+				std::weak_ptr<State> pool;
+				Magazine magazine;
+			};
+
+		public:
+			ThreadCache() = default;
+			ThreadCache(const ThreadCache&) = delete;
+			~ThreadCache();
+
+			ThreadCache& operator=(const ThreadCache&) = delete;
+
+			Magazine& magazineFor(const std::shared_ptr<State>& pool);
+
+		private:
+			Magazine& addEntryFor(const std::shared_ptr<State>& pool);
+			void removeEntriesOfDestroyedPools();
+
+		private:
+			std::vector<Entry> entries;
+			std::size_t lastUsed = 0;
+		};
+
+		//set once the thread's cache is destroyed, so that pools used by
+		//objects outliving it, e.g. statics destroyed after the main thread's
+		//thread locals, go to the depot instead. trivially destructible,
+		//it stays readable for the whole lifetime of the thread
+		thread_local bool isThreadCacheDestroyed = false;
+		thread_local ThreadCache threadCache;
+
+		ThreadCache::~ThreadCache()
+		{
+			isThreadCacheDestroyed = true;
+
+			for (auto& entry : entries)
+			{
+				if (auto pool = entry.pool.lock(); pool != nullptr)
+				{
+					pool->giveBack(entry.magazine);
+				}
+			}
+		}
+
+		Magazine& ThreadCache::magazineFor(const std::shared_ptr<State>& pool)
+		{
+			if (lastUsed < entries.size() && entries[lastUsed].poolId == pool->id)
+			{
+				return entries[lastUsed].magazine;
+			}
+
+			for (auto i = std::size_t{ 0 }; i < entries.size(); ++i)
+			{
+				if (entries[i].poolId == pool->id)
+				{
+					lastUsed = i;
+					return entries[i].magazine;
+				}
+			}
+
+			return addEntryFor(pool);
+		}
+
+		Magazine& ThreadCache::addEntryFor(const std::shared_ptr<State>& pool)
+		{
+			removeEntriesOfDestroyedPools();
+			entries.push_back({ pool->id, pool, Magazine{} });
+			lastUsed = entries.size() - 1;
+
+			return entries.back().magazine;
+		}
+
+		void ThreadCache::removeEntriesOfDestroyedPools()
+		{
+			auto isDestroyed = [](const Entry& entry) { return entry.pool.expired(); };
+			entries.erase(std::remove_if(entries.begin(), entries.end(), isDestroyed), entries.end());
+		}
+	}
+
+	FixedBlockPool::State::State(std::size_t blockSize, std::size_t blocksPerChunk) :
+		id(nextId()),
+		blockSize(roundUp(std::max(blockSize, sizeof(FreeBlock)), getAlignment())),
+		blocksPerChunk(std::max(blocksPerChunk, std::size_t{ 1 }))
+	{
+	}
+
+	std::uint64_t FixedBlockPool::State::nextId() noexcept
+	{
+		static std::atomic<std::uint64_t> lastId = 0;
+		return lastId.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	void FixedBlockPool::State::refill(Magazine& magazine)
+	{
+		if (auto chain = depot.pop(); chain != nullptr)
+		{
+			magazine.top = chain;
+			magazine.count = chain->count;
+		}
+		else
+		{
+			grow(magazine);
+		}
+	}
+
+	//keeps a full magazine in the thread, so that a thread alternating
+	//between allocations and deallocations does not hit the depot each time
+	void FixedBlockPool::State::spill(Magazine& magazine) noexcept
+	{
+		if (magazine.count >= 2 * MAGAZINE_CAPACITY)
+		{
+			depot.push(magazine.detachChain(MAGAZINE_CAPACITY));
+		}
+	}
+
+	void FixedBlockPool::State::giveBack(Magazine& magazine) noexcept
+	{
+		while (!magazine.isEmpty())
+		{
+			depot.push(magazine.detachChain(std::min(magazine.count, MAGAZINE_CAPACITY)));
+		}
+	}
+
+	//the first chain of the new chunk goes to the magazine, the rest to the depot
+	void FixedBlockPool::State::grow(Magazine& magazine)
+	{
+		auto chunk = std::unique_ptr<std::byte[]>(new std::byte[blockSize * blocksPerChunk]);
+		auto first = static_cast<FreeBlock*>(nullptr);
+		auto last = first;
+
+		for (auto begin = std::size_t{ 0 }; begin < blocksPerChunk; begin += MAGAZINE_CAPACITY)
+		{
+			auto chain = makeChain(chunk.get(), begin, std::min(begin + MAGAZINE_CAPACITY, blocksPerChunk));
+
+			if (begin == 0)
+			{
+				magazine.top = chain;
+				magazine.count = chain->count;
+			}
+			else if (first == nullptr)
+			{
+				first = last = chain;
+			}
+			else
+			{
+				last->nextChain.store(chain, std::memory_order_relaxed);
+				last = chain;
+			}
+		}
+
+		{
+			auto lock = std::lock_guard<std::mutex>(chunksMutex);
+			chunks.push_back(std::move(chunk));
+		}
+
+		if (first != nullptr)
+		{
+			depot.pushAll(first, last);
+		}
+	}
+
+	FreeBlock* FixedBlockPool::State::makeChain(std::byte* chunk, std::size_t begin, std::size_t end) const noexcept
+	{
+		auto first = static_cast<FreeBlock*>(nullptr);
+
+		for (auto i = end; i-- > begin; )
+		{
+			auto block = ::new (chunk + i * blockSize) FreeBlock;
+			block->next = first;
+			first = block;
+		}
+
+		first->count = end - begin;
+
+		return first;
+	}
+
+	FixedBlockPool::FixedBlockPool(std::size_t blockSize, std::size_t blocksPerChunk) :
+		state(std::make_shared<State>(blockSize, blocksPerChunk))
+	{
+	}
+
+	void* FixedBlockPool::allocate()
+	{
+		if (isThreadCacheDestroyed)
+		{
+			auto magazine = Magazine{};
+			state->refill(magazine);
+			auto block = magazine.pop();
+			state->giveBack(magazine);
+
+			return block;
+		}
+
+		auto& magazine = threadCache.magazineFor(state);
+
+		if (magazine.isEmpty())
+		{
+			state->refill(magazine);
+		}
+
+		return magazine.pop();
+	}
+
+	void FixedBlockPool::deallocate(void* block) noexcept
+	{
+		auto freeBlock = ::new (block) FreeBlock;
+
+		if (isThreadCacheDestroyed)
+		{
+			freeBlock->count = 1;
+			state->depot.push(freeBlock);
+			return;
+		}
+
+		try
+		{
+			auto& magazine = threadCache.magazineFor(state);
+			magazine.push(freeBlock);
+			state->spill(magazine);
+		}
+		catch (std::bad_alloc&)
+		{
+			//the thread could not get a magazine, the depot takes the block alone
+			freeBlock->count = 1;
+			state->depot.push(freeBlock);
+		}
+	}
+
+	std::size_t FixedBlockPool::getBlockSize() const noexcept
+	{
+		return state->blockSize;
+	}
+}
@@ -0,0 +1,46 @@
+#ifndef __FIXED_BLOCK_POOL_H_INCLUDED__
+#define __FIXED_BLOCK_POOL_H_INCLUDED__
+
+#include <cstddef>
+#include <memory>
+
+namespace IDragnev::Multithreading
+{
+	//Hands out blocks of one fixed size without going to the global allocator
+	//once it has warmed up.
+	//Every thread keeps a magazine of free blocks per pool, so most
+	//allocations and deallocations touch no shared state at all.
+	//Magazines are exchanged with a shared lock-free depot in whole chains,
+	//one CAS per chain. The pool grows by chunks and returns its memory
+	//only when it is destroyed.
+	//A thread which exits gives its magazines back to the pools still alive.
+	//Blocks allocated or deallocated after that, e.g. by static objects
+	//destroyed after the main thread's thread locals, bypass the magazines.
+	class FixedBlockPool
+	{
+	public:
+		//defined with the implementation, shared with the thread caches
+		struct State;
+
+		static constexpr std::size_t MAGAZINE_CAPACITY = 64;
+		static constexpr std::size_t DEFAULT_BLOCKS_PER_CHUNK = 16 * MAGAZINE_CAPACITY;
+
+		explicit FixedBlockPool(std::size_t blockSize,
+			                    std::size_t blocksPerChunk = DEFAULT_BLOCKS_PER_CHUNK);
+		FixedBlockPool(const FixedBlockPool&) = delete;
+		~FixedBlockPool() = default;
+
+		FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+		void* allocate();
+		void deallocate(void* block) noexcept;
+
+		std::size_t getBlockSize() const noexcept;
+		static constexpr std::size_t getAlignment() noexcept { return alignof(std::max_align_t); }
+
+	private:
+		std::shared_ptr<State> state;
+	};
+}
+
+#endif //__FIXED_BLOCK_POOL_H_INCLUDED__
@@ -0,0 +1,53 @@
+#ifndef __OBJECT_POOL_H_INCLUDED__
+#define __OBJECT_POOL_H_INCLUDED__
+
+#include "FixedBlockPool.h"
+#include <memory>
+
+namespace IDragnev::Multithreading
+{
+	//Constructs objects of type T in blocks of a FixedBlockPool.
+	//Objects may be created and destroyed by different threads.
+	//The pool must outlive every object it has created.
+	template <typename T>
+	class ObjectPool
+	{
+	private:
+		static_assert(alignof(T) <= FixedBlockPool::getAlignment(),
+			          "ObjectPool does not support over-aligned types");
+
+		class Deleter
+		{
+		public:
+			Deleter(ObjectPool* pool = nullptr) noexcept : pool(pool) { }
+
+			void operator()(T* object) const noexcept { pool->destroy(object); }
+
+		private:
+			ObjectPool* pool;
+		};
+
+	public:
+		using Handle = std::unique_ptr<T, Deleter>;
+
+		explicit ObjectPool(std::size_t objectsPerChunk = FixedBlockPool::DEFAULT_BLOCKS_PER_CHUNK);
+		ObjectPool(const ObjectPool&) = delete;
+		~ObjectPool() = default;
+
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		template <typename... Args>
+		T* construct(Args&&... args);
+		void destroy(T* object) noexcept;
+
+		template <typename... Args>
+		Handle make(Args&&... args);
+
+	private:
+		FixedBlockPool blocks;
+	};
+}
+
+#include "ObjectPoolImpl.hpp"
+
+#endif //__OBJECT_POOL_H_INCLUDED__
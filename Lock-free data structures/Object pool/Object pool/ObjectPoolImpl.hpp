@@ -0,0 +1,45 @@
+#include <new>
+#include <utility>
+
+namespace IDragnev::Multithreading
+{
+	template <typename T>
+	ObjectPool<T>::ObjectPool(std::size_t objectsPerChunk) :
+		blocks(sizeof(T), objectsPerChunk)
+	{
+	}
+
+	template <typename T>
+	template <typename... Args>
+	T* ObjectPool<T>::construct(Args&&... args)
+	{
+		auto block = blocks.allocate();
+
+		try
+		{
+			return ::new (block) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			blocks.deallocate(block);
+			throw;
+		}
+	}
+
+	template <typename T>
+	void ObjectPool<T>::destroy(T* object) noexcept
+	{
+		if (object != nullptr)
+		{
+			object->~T();
+			blocks.deallocate(object);
+		}
+	}
+
+	template <typename T>
+	template <typename... Args>
+	auto ObjectPool<T>::make(Args&&... args) -> Handle
+	{
+		return Handle{ construct(std::forward<Args>(args)...), Deleter{ this } };
+	}
+}
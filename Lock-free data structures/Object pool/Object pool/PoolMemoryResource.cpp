@@ -0,0 +1,37 @@
+#include "PoolMemoryResource.h"
+
+namespace IDragnev::Multithreading
+{
+	PoolMemoryResource::PoolMemoryResource(std::size_t blockSize, std::pmr::memory_resource* upstream) :
+		pool(blockSize),
+		upstream(upstream)
+	{
+	}
+
+	void* PoolMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		return fitsInABlock(bytes, alignment) ? pool.allocate() : upstream->allocate(bytes, alignment);
+	}
+
+	void PoolMemoryResource::do_deallocate(void* block, std::size_t bytes, std::size_t alignment)
+	{
+		if (fitsInABlock(bytes, alignment))
+		{
+			pool.deallocate(block);
+		}
+		else
+		{
+			upstream->deallocate(block, bytes, alignment);
+		}
+	}
+
+	bool PoolMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	bool PoolMemoryResource::fitsInABlock(std::size_t bytes, std::size_t alignment) const noexcept
+	{
+		return bytes <= pool.getBlockSize() && alignment <= FixedBlockPool::getAlignment();
+	}
+}
@@ -0,0 +1,37 @@
+#ifndef __POOL_MEMORY_RESOURCE_H_INCLUDED__
+#define __POOL_MEMORY_RESOURCE_H_INCLUDED__
+
+#include "FixedBlockPool.h"
+#include <memory_resource>
+
+namespace IDragnev::Multithreading
+{
+	//A memory resource for node based containers:
+	//requests which fit in a block are served by a FixedBlockPool,
+	//the rest are forwarded to the upstream resource.
+	class PoolMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		explicit PoolMemoryResource(std::size_t blockSize,
+			                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+		PoolMemoryResource(const PoolMemoryResource&) = delete;
+		~PoolMemoryResource() = default;
+
+		PoolMemoryResource& operator=(const PoolMemoryResource&) = delete;
+
+		std::pmr::memory_resource* getUpstream() const noexcept { return upstream; }
+
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		bool fitsInABlock(std::size_t bytes, std::size_t alignment) const noexcept;
+
+	private:
+		FixedBlockPool pool;
+		std::pmr::memory_resource* upstream;
+	};
+}
+
+#endif //__POOL_MEMORY_RESOURCE_H_INCLUDED__
@@ -0,0 +1,92 @@
+#ifndef __TAGGED_FREE_LIST_H_INCLUDED__
+#define __TAGGED_FREE_LIST_H_INCLUDED__
+
+#define _ENABLE_ATOMIC_ALIGNMENT_FIX
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace IDragnev::Multithreading
+{
+	//The header a free block carries while it sits in a pool.
+	//Blocks form chains of up to a magazine's capacity through next;
+	//the first block of every chain links to the next chain in the
+	//free list through nextChain and knows the chain's length.
+	struct FreeBlock
+	{
+		FreeBlock* next = nullptr;
+		std::atomic<FreeBlock*> nextChain = nullptr;
+		std::size_t count = 0;
+	};
+
+	//A lock-free stack of block chains. The head carries a tag which
+	//changes on every update, so a pop which read a stale nextChain
+	//fails its CAS even if the same block is back on top (ABA).
+	//A racing pop may read nextChain from a block which was handed out
+	//meanwhile, so the memory of the blocks must never be freed while
+	//the list is in use.
+	class TaggedFreeList
+	{
+	private:
+		struct TaggedBlockPtr
+		{
+			FreeBlock* block;
+			std::uintptr_t tag;
+		};
+
+	public:
+		TaggedFreeList() noexcept :
+			head({ nullptr, 0 })
+		{
+		}
+		TaggedFreeList(const TaggedFreeList&) = delete;
+		~TaggedFreeList() = default;
+
+		TaggedFreeList& operator=(const TaggedFreeList&) = delete;
+
+		void push(FreeBlock* chain) noexcept
+		{
+			pushAll(chain, chain);
+		}
+
+		//first and last are the ends of a list linked through nextChain
+		void pushAll(FreeBlock* first, FreeBlock* last) noexcept
+		{
+			auto oldHead = head.load(std::memory_order_relaxed);
+			auto newHead = TaggedBlockPtr{};
+
+			do
+			{
+				last->nextChain.store(oldHead.block, std::memory_order_relaxed);
+				newHead = { first, oldHead.tag + 1 };
+			} while (!head.compare_exchange_weak(oldHead, newHead,
+				                                 std::memory_order_release,
+				                                 std::memory_order_relaxed));
+		}
+
+		FreeBlock* pop() noexcept
+		{
+			auto oldHead = head.load(std::memory_order_acquire);
+
+			while (oldHead.block != nullptr)
+			{
+				auto newHead = TaggedBlockPtr{ oldHead.block->nextChain.load(std::memory_order_relaxed), oldHead.tag + 1 };
+
+				if (head.compare_exchange_weak(oldHead, newHead,
+					                           std::memory_order_acquire,
+					                           std::memory_order_acquire))
+				{
+					return oldHead.block;
+				}
+			}
+
+			return nullptr;
+		}
+
+	private:
+		std::atomic<TaggedBlockPtr> head;
+	};
+}
+
+#endif //__TAGGED_FREE_LIST_H_INCLUDED__
@@ -0,0 +1,55 @@
+#include "ObjectPool.h"
+#include "PoolMemoryResource.h"
+#include "SmartThread.h"
+#include <list>
+#include <vector>
+
+using IDragnev::Multithreading::ObjectPool;
+using IDragnev::Multithreading::PoolMemoryResource;
+using IDragnev::Multithreading::SmartThread;
+
+struct X
+{
+	X(int x, int* y) :
+		x(x), y(y)
+	{
+	}
+
+	int x = 0;
+	int* y = nullptr;
+};
+
+int main()
+{
+	auto pool = ObjectPool<X>{};
+
+	{
+		auto handle = pool.make(1, nullptr);
+		auto object = pool.construct(2, nullptr);
+		pool.destroy(object);
+	}
+
+	{
+		auto objects = std::vector<X*>(1000);
+		for (auto& object : objects)
+		{
+			object = pool.construct(3, nullptr);
+		}
+
+		//objects are released by a thread other than the one that created them
+		auto releaser = SmartThread{ std::thread{ [&pool, &objects]
+		{
+			for (auto object : objects)
+			{
+				pool.destroy(object);
+			}
+		} } };
+	}
+
+	auto resource = PoolMemoryResource{ 32 };
+	auto list = std::pmr::list<int>{ &resource };
+	for (auto i = 0; i < 100; ++i)
+	{
+		list.push_back(i);
+	}
+}
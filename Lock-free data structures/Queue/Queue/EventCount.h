@@ -0,0 +1,112 @@
+#ifndef __EVENT_COUNT_H_INCLUDED__
+#define __EVENT_COUNT_H_INCLUDED__
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+namespace IDragnev::Multithreading
+{
+	//Lets threads sleep until a lock-free condition becomes true.
+	//Waiters follow the protocol:
+	//    auto key = prepareWait();
+	//    if (condition holds) cancelWait(); else wait(key);
+	//Notifiers change the condition first and then call notify.
+	//Notifying is a single atomic load when nobody is waiting.
+	class EventCount
+	{
+	private:
+		using LockGuard = std::lock_guard<std::mutex>;
+		using UniqueLock = std::unique_lock<std::mutex>;
+
+	public:
+		using Key = std::uint32_t;
+
+	private:
+		auto epochDiffersFrom(Key key) const noexcept
+		{
+			return [this, key] { return epoch.load(std::memory_order_acquire) != key; };
+		}
+
+	public:
+		EventCount() = default;
+		EventCount(const EventCount&) = delete;
+		~EventCount() = default;
+
+		EventCount& operator=(const EventCount&) = delete;
+
+		Key prepareWait() noexcept
+		{
+			waiters.fetch_add(1, std::memory_order_seq_cst);
+			return epoch.load(std::memory_order_acquire);
+		}
+
+		void cancelWait() noexcept
+		{
+			waiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void wait(Key key)
+		{
+			auto lock = UniqueLock(mutex);
+			condition.wait(lock, epochDiffersFrom(key));
+			waiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		//returns false if the timeout expired before a notification
+		template <typename Rep, typename Period>
+		bool waitFor(Key key, const std::chrono::duration<Rep, Period>& timeout)
+		{
+			auto lock = UniqueLock(mutex);
+			auto notified = condition.wait_for(lock, timeout, epochDiffersFrom(key));
+			waiters.fetch_sub(1, std::memory_order_relaxed);
+
+			return notified;
+		}
+
+		void notifyOne() noexcept
+		{
+			if (hasWaiters())
+			{
+				advanceEpoch();
+				condition.notify_one();
+			}
+		}
+
+		void notifyAll() noexcept
+		{
+			if (hasWaiters())
+			{
+				advanceEpoch();
+				condition.notify_all();
+			}
+		}
+
+	private:
+		bool hasWaiters() const noexcept
+		{
+			//pairs with the increment in prepareWait:
+			//either the waiter sees the new state or we see the waiter
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			return waiters.load(std::memory_order_relaxed) != 0;
+		}
+
+		void advanceEpoch() noexcept
+		{
+			//the mutex closes the window between a waiter's
+			//epoch check and its going to sleep
+			auto lock = LockGuard(mutex);
+			epoch.fetch_add(1, std::memory_order_release);
+		}
+
+	private:
+		std::atomic<Key> epoch = 0;
+		std::atomic<std::uint32_t> waiters = 0;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+}
+
+#endif //__EVENT_COUNT_H_INCLUDED__
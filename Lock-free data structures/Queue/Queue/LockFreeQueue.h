@@ -3,22 +3,28 @@
 
 #define _ENABLE_ATOMIC_ALIGNMENT_FIX
 
+#include "EventCount.h"
+#include "Lock-free data structures\Backoff.h"
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 
 namespace IDragnev::Multithreading
 {
-	template <typename T>
+	//Backoff is called after every failed CAS, see Backoff.h
+	template <typename T, typename Backoff = NoBackoff>
 	class LockFreeQueue
 	{
 	private:
 		struct Node;
 
+		//the counter is pointer-sized so that the struct has no padding
+		//bytes for compare_exchange to compare
 		struct RefCountedNodePtr
 		{
 			Node* node;
-			std::int32_t externalCount = 1;
+			std::intptr_t externalCount = 1;
 		};
 
 		using AtomicRefCountedNodePtr = std::atomic<RefCountedNodePtr>;
@@ -55,9 +61,20 @@ namespace IDragnev::Multithreading
 		void enqueue(T&& item);
 		void enqueue(const T& item);
 		std::unique_ptr<T> extractFront() noexcept;
+		//return nullptr once the queue is closed and drained
+		std::unique_ptr<T> waitAndExtractFront();
+		template <typename Rep, typename Period>
+		std::unique_ptr<T> waitAndExtractFront(const std::chrono::duration<Rep, Period>& timeout);
+
+		//Wakes all waiting consumers. Enqueueing is not refused,
+		//so producers are expected to be done before the queue is closed.
+		void close() noexcept;
+		bool isClosed() const noexcept;
 
 	private:
 		void enqueue(std::unique_ptr<T> newData);
+		template <typename Callable>
+		std::unique_ptr<T> extractFrontWaitingWith(Callable wait);
 
 		RefCountedNodePtr getHeadIncreasingItsRefCount(RefCountedNodePtr oldHead) noexcept;
 		RefCountedNodePtr getTailIncreasingItsRefCount(RefCountedNodePtr oldTail) noexcept;
@@ -65,6 +82,7 @@ namespace IDragnev::Multithreading
 		Node* getTailNode() noexcept;
 
 		static const RefCountedNodePtr emptyRefCountedNodePtr;
+		static T* const consumedData;
 		
 	   	static std::unique_ptr<T> extractDataOf(Node* node) noexcept;
 		static void releaseReferenceTo(Node* node) noexcept;
@@ -77,6 +95,10 @@ namespace IDragnev::Multithreading
 	private:
 		AtomicRefCountedNodePtr head;
 		AtomicRefCountedNodePtr tail;
+		EventCount itemsAvailable;
+		std::atomic<bool> closed = false;
+
+		inline static char consumedDataTag;
 	};
 }
 
@@ -1,37 +1,45 @@
 
 namespace IDragnev::Multithreading
 {
-	template <typename T>
-	typename const LockFreeQueue<T>::RefCountedNodePtr LockFreeQueue<T>::emptyRefCountedNodePtr = { nullptr, 0 };
+	template <typename T, typename Backoff>
+	typename const LockFreeQueue<T, Backoff>::RefCountedNodePtr LockFreeQueue<T, Backoff>::emptyRefCountedNodePtr = { nullptr, 0 };
 
-	template <typename T>
-	LockFreeQueue<T>::LockFreeQueue() :
+	//marks the data of a dequeued node as taken, so that a producer
+	//still holding that node as its old tail cannot store into it
+	template <typename T, typename Backoff>
+	T* const LockFreeQueue<T, Backoff>::consumedData = reinterpret_cast<T*>(&LockFreeQueue<T, Backoff>::consumedDataTag);
+
+	template <typename T, typename Backoff>
+	LockFreeQueue<T, Backoff>::LockFreeQueue() :
 		head{ { new Node } },
 		tail{ head.load() }
 	{
 	}
 
-	template <typename T>
-	LockFreeQueue<T>::~LockFreeQueue()
+	template <typename T, typename Backoff>
+	LockFreeQueue<T, Backoff>::~LockFreeQueue()
 	{
 		decltype(extractFront()) extracted = nullptr;
 		do
 		{
 			extracted = extractFront();
 		} while (extracted != nullptr);
+
+		delete head.load().node;
 	}
 
-	template <typename T>
-	std::unique_ptr<T> LockFreeQueue<T>::extractFront() noexcept
+	template <typename T, typename Backoff>
+	std::unique_ptr<T> LockFreeQueue<T, Backoff>::extractFront() noexcept
 	{
 		auto oldHead = head.load(std::memory_order_relaxed);
-		for (;;)
+		for (auto backoff = Backoff{}; ; backoff())
 		{
 			oldHead = getHeadIncreasingItsRefCount(oldHead);
 			auto node = oldHead.node;
 
 			if (node == getTailNode())
 			{
+				releaseReferenceTo(node);
 				return nullptr;
 			}
 
@@ -47,43 +55,114 @@ namespace IDragnev::Multithreading
 		}
 	}
 
-	template <typename T>
-	inline auto LockFreeQueue<T>::getHeadIncreasingItsRefCount(RefCountedNodePtr oldHead) noexcept -> RefCountedNodePtr
+	template <typename T, typename Backoff>
+	std::unique_ptr<T> LockFreeQueue<T, Backoff>::waitAndExtractFront()
+	{
+		return extractFrontWaitingWith([this](auto key)
+		{
+			itemsAvailable.wait(key);
+			return true;
+		});
+	}
+
+	template <typename T, typename Backoff>
+	template <typename Rep, typename Period>
+	std::unique_ptr<T> LockFreeQueue<T, Backoff>::waitAndExtractFront(const std::chrono::duration<Rep, Period>& timeout)
+	{
+		using Clock = std::chrono::steady_clock;
+		const auto deadline = Clock::now() + timeout;
+
+		return extractFrontWaitingWith([this, deadline](auto key)
+		{
+			return itemsAvailable.waitFor(key, deadline - Clock::now());
+		});
+	}
+
+	template <typename T, typename Backoff>
+	template <typename Callable>
+	std::unique_ptr<T> LockFreeQueue<T, Backoff>::extractFrontWaitingWith(Callable wait)
+	{
+		for (;;)
+		{
+			if (auto result = extractFront();
+				result != nullptr)
+			{
+				return result;
+			}
+
+			auto key = itemsAvailable.prepareWait();
+			if (auto result = extractFront();
+				result != nullptr)
+			{
+				itemsAvailable.cancelWait();
+				return result;
+			}
+			else if (isClosed())
+			{
+				//items enqueued before the closing may have been missed above
+				itemsAvailable.cancelWait();
+				return extractFront();
+			}
+			else if (!wait(key))
+			{
+				return extractFront();
+			}
+		}
+	}
+
+	template <typename T, typename Backoff>
+	void LockFreeQueue<T, Backoff>::close() noexcept
+	{
+		closed.store(true);
+		itemsAvailable.notifyAll();
+	}
+
+	template <typename T, typename Backoff>
+	inline bool LockFreeQueue<T, Backoff>::isClosed() const noexcept
+	{
+		return closed.load();
+	}
+
+	template <typename T, typename Backoff>
+	inline auto LockFreeQueue<T, Backoff>::getHeadIncreasingItsRefCount(RefCountedNodePtr oldHead) noexcept -> RefCountedNodePtr
 	{
 		return increaseExternalCount(head, oldHead);
 	}
 
-	template <typename T>
-	auto LockFreeQueue<T>::increaseExternalCount(AtomicRefCountedNodePtr& source, RefCountedNodePtr oldValue) noexcept -> RefCountedNodePtr
+	template <typename T, typename Backoff>
+	auto LockFreeQueue<T, Backoff>::increaseExternalCount(AtomicRefCountedNodePtr& source, RefCountedNodePtr oldValue) noexcept -> RefCountedNodePtr
 	{
 		RefCountedNodePtr result;
 
-		do
+		for (auto backoff = Backoff{}; ; backoff())
 		{
 			result = oldValue;
 			++result.externalCount;
-		} while (!source.compare_exchange_strong(oldValue, result,
-			      std::memory_order_acquire,
-			      std::memory_order_relaxed));
-		
-		return result;
+
+			if (source.compare_exchange_strong(oldValue, result,
+				                               std::memory_order_acquire,
+				                               std::memory_order_relaxed))
+			{
+				return result;
+			}
+		}
 	}
 
-	template <typename T>
-	inline auto LockFreeQueue<T>::getTailNode() noexcept -> Node*
+	template <typename T, typename Backoff>
+	inline auto LockFreeQueue<T, Backoff>::getTailNode() noexcept -> Node*
 	{
 		return tail.load().node;
 	}
 
-	template <typename T>
-	inline std::unique_ptr<T> LockFreeQueue<T>::extractDataOf(Node* node) noexcept
+	template <typename T, typename Backoff>
+	inline std::unique_ptr<T> LockFreeQueue<T, Backoff>::extractDataOf(Node* node) noexcept
 	{
-		auto data = node->data.exchange(nullptr);
+		auto data = node->data.exchange(consumedData);
 		return std::unique_ptr<T>{data};
 	}
 
-	template <typename T>
-	void LockFreeQueue<T>::releaseReferenceTo(Node* node) noexcept
+	template <typename T, typename Backoff>
+	void LockFreeQueue<T, Backoff>::releaseReferenceTo(Node* node) noexcept
 	{
 		updateRefCountOf(node, [](auto oldCount)
 		{
@@ -92,25 +171,27 @@ namespace IDragnev::Multithreading
 		});
 	}
 
-	template <typename T>
+	template <typename T, typename Backoff>
 	template <typename Callable>
-	void LockFreeQueue<T>::updateRefCountOf(Node* node, Callable update) noexcept
+	void LockFreeQueue<T, Backoff>::updateRefCountOf(Node* node, Callable update) noexcept
 	{
 		auto oldCount = node->count.load(std::memory_order_relaxed);
-		decltype(oldCount) newCount;
+		auto newCount = update(oldCount);
 
-		do
+		for (auto backoff = Backoff{};
+			 !node->count.compare_exchange_strong(oldCount, newCount,
+				                                  std::memory_order_acquire,
+				                                  std::memory_order_relaxed);
+			 backoff())
 		{
 			newCount = update(oldCount);
-		} while (!node->count.compare_exchange_strong(
-			       oldCount, newCount,
-		   	       std::memory_order_acquire, std::memory_order_relaxed));
+		}
 
 		deleteIfNotReferenced(node, newCount);
 	}
 
-	template <typename T>
-	inline void LockFreeQueue<T>::deleteIfNotReferenced(Node* node, const RefCount& count) noexcept
+	template <typename T, typename Backoff>
+	inline void LockFreeQueue<T, Backoff>::deleteIfNotReferenced(Node* node, const RefCount& count) noexcept
 	{
 		if (count.internalCount == 0 &&
 			count.externalCounters == 0)
@@ -119,32 +200,32 @@ namespace IDragnev::Multithreading
 		}
 	}
 
-	template <typename T>
+	template <typename T, typename Backoff>
 	template <typename... Args>
-	inline void LockFreeQueue<T>::emplace(Args&&... args)
+	inline void LockFreeQueue<T, Backoff>::emplace(Args&&... args)
 	{
 		enqueue(std::make_unique<T>(std::forward<Args>(args)...));
 	}
 
-	template <typename T>
-	inline void LockFreeQueue<T>::enqueue(const T& item)
+	template <typename T, typename Backoff>
+	inline void LockFreeQueue<T, Backoff>::enqueue(const T& item)
 	{
 		enqueue(std::make_unique<T>(item));
 	}
 
-	template <typename T>
-	inline void LockFreeQueue<T>::enqueue(T&& item)
+	template <typename T, typename Backoff>
+	inline void LockFreeQueue<T, Backoff>::enqueue(T&& item)
 	{
 		enqueue(std::make_unique<T>(std::move(item)));
 	}
 
-	template <typename T>
-	void LockFreeQueue<T>::enqueue(std::unique_ptr<T> newData)
+	template <typename T, typename Backoff>
+	void LockFreeQueue<T, Backoff>::enqueue(std::unique_ptr<T> newData)
 	{
 		auto newNext = RefCountedNodePtr{ new Node };
 		auto oldTail = tail.load();
 
-		for (;;)
+		for (auto backoff = Backoff{}; ; backoff())
 		{
 			oldTail = getTailIncreasingItsRefCount(oldTail);
 
@@ -159,6 +240,7 @@ namespace IDragnev::Multithreading
 				}
 				setTail(oldTail, newNext);
 				newData.release();
+				itemsAvailable.notifyOne();
 				break;
 			}
 			else
@@ -174,19 +256,20 @@ namespace IDragnev::Multithreading
 		}
 	}
 
-	template <typename T>
-	inline auto LockFreeQueue<T>::getTailIncreasingItsRefCount(RefCountedNodePtr oldTail) noexcept -> RefCountedNodePtr
+	template <typename T, typename Backoff>
+	inline auto LockFreeQueue<T, Backoff>::getTailIncreasingItsRefCount(RefCountedNodePtr oldTail) noexcept -> RefCountedNodePtr
 	{
 		return increaseExternalCount(tail, oldTail);
 	}
 
-	template <typename T>
-	void LockFreeQueue<T>::setTail(RefCountedNodePtr& oldTail, const RefCountedNodePtr& newTail) noexcept
+	template <typename T, typename Backoff>
+	void LockFreeQueue<T, Backoff>::setTail(RefCountedNodePtr& oldTail, const RefCountedNodePtr& newTail) noexcept
 	{
 		auto node = oldTail.node;
 
-		while (!tail.compare_exchange_weak(oldTail, newTail) &&
-			   oldTail.node == node)
+		for (auto backoff = Backoff{};
+			 !tail.compare_exchange_weak(oldTail, newTail) && oldTail.node == node;
+			 backoff())
 		{ }
 
 		if (oldTail.node == node)
@@ -199,8 +282,8 @@ namespace IDragnev::Multithreading
 		}
 	}
 
-	template <typename T>
-	void LockFreeQueue<T>::releaseExternalCounter(RefCountedNodePtr& ptr) noexcept
+	template <typename T, typename Backoff>
+	void LockFreeQueue<T, Backoff>::releaseExternalCounter(RefCountedNodePtr& ptr) noexcept
 	{
 		auto increase = ptr.externalCount - 2;
 
@@ -0,0 +1,52 @@
+
+namespace IDragnev::Multithreading
+{
+	template <typename T, typename Backoff>
+	LockFreeStack<T, Backoff>::Batch::Batch(RefCountedNodePtr first) noexcept :
+		first{ first }
+	{
+	}
+
+	template <typename T, typename Backoff>
+	LockFreeStack<T, Backoff>::Batch::Batch(Batch&& source) noexcept :
+		first{ source.first }
+	{
+		source.first = { nullptr, 0 };
+	}
+
+	template <typename T, typename Backoff>
+	LockFreeStack<T, Backoff>::Batch::~Batch()
+	{
+		clear();
+	}
+
+	template <typename T, typename Backoff>
+	auto LockFreeStack<T, Backoff>::Batch::operator=(Batch&& rhs) noexcept -> Batch&
+	{
+		if (this != &rhs)
+		{
+			clear();
+			first = rhs.first;
+			rhs.first = { nullptr, 0 };
+		}
+
+		return *this;
+	}
+
+	template <typename T, typename Backoff>
+	void LockFreeStack<T, Backoff>::Batch::clear() noexcept
+	{
+		//any of the nodes may still be referenced by a popper which loaded it
+		//as the head before later pushes buried it, so each is released through
+		//the count held by its predecessor, with the reference popAll never took
+		for (auto detached = first; detached.node != nullptr; )
+		{
+			auto next = detached.node->next;
+			++detached.externalCount;
+			updateRefCountAndFreeNodeIfNotReferenced(detached);
+			detached = next;
+		}
+
+		first = { nullptr, 0 };
+	}
+}
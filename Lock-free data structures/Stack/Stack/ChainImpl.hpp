@@ -0,0 +1,83 @@
+
+namespace IDragnev::Multithreading
+{
+	template <typename T, typename Backoff>
+	LockFreeStack<T, Backoff>::Chain::Chain(Chain&& source) noexcept :
+		first{ source.first },
+		last{ source.last }
+	{
+		source.release();
+	}
+
+	template <typename T, typename Backoff>
+	LockFreeStack<T, Backoff>::Chain::~Chain()
+	{
+		clear();
+	}
+
+	template <typename T, typename Backoff>
+	auto LockFreeStack<T, Backoff>::Chain::operator=(Chain&& rhs) noexcept -> Chain&
+	{
+		if (this != &rhs)
+		{
+			clear();
+			first = rhs.first;
+			last = rhs.last;
+			rhs.release();
+		}
+
+		return *this;
+	}
+
+	template <typename T, typename Backoff>
+	template <typename... Args>
+	void LockFreeStack<T, Backoff>::Chain::emplace(Args&&... args)
+	{
+		auto ptr = makeRefCountedNodePtr(std::forward<Args>(args)...);
+		ptr.node->next = first;
+		first = ptr;
+
+		if (last == nullptr)
+		{
+			last = ptr.node;
+		}
+	}
+
+	template <typename T, typename Backoff>
+	inline void LockFreeStack<T, Backoff>::Chain::push(const T& item)
+	{
+		emplace(item);
+	}
+
+	template <typename T, typename Backoff>
+	inline void LockFreeStack<T, Backoff>::Chain::push(T&& item)
+	{
+		emplace(std::move(item));
+	}
+
+	template <typename T, typename Backoff>
+	inline bool LockFreeStack<T, Backoff>::Chain::isEmpty() const noexcept
+	{
+		return first.node == nullptr;
+	}
+
+	template <typename T, typename Backoff>
+	inline void LockFreeStack<T, Backoff>::Chain::release() noexcept
+	{
+		first = { nullptr, 0 };
+		last = nullptr;
+	}
+
+	template <typename T, typename Backoff>
+	void LockFreeStack<T, Backoff>::Chain::clear() noexcept
+	{
+		for (auto node = first.node; node != nullptr; )
+		{
+			auto next = node->next.node;
+			delete node;
+			node = next;
+		}
+
+		release();
+	}
+}
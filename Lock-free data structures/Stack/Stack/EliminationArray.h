@@ -0,0 +1,135 @@
+#ifndef __ELIMINATION_ARRAY_H_INCLUDED__
+#define __ELIMINATION_ARRAY_H_INCLUDED__
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace IDragnev::Multithreading
+{
+	//A place where a push and a pop which collided on the head
+	//of a stack can meet and complete each other.
+	//A pusher offers its node in a random slot and waits for a while;
+	//a popper takes whatever node is offered in a random slot.
+	template <typename Node>
+	class EliminationArray
+	{
+	private:
+		static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+		struct alignas(CACHE_LINE_SIZE) Slot
+		{
+			std::atomic<Node*> offer = nullptr;
+		};
+
+	public:
+		explicit EliminationArray(std::size_t width);
+		EliminationArray(const EliminationArray&) = delete;
+		~EliminationArray() = default;
+
+		EliminationArray& operator=(const EliminationArray&) = delete;
+
+		bool tryToHandOff(Node* node) noexcept;
+		Node* tryToTake() noexcept;
+
+	private:
+		Slot& randomSlot() noexcept;
+		static bool waitToBeTaken(Slot& slot) noexcept;
+		static Node* taken() noexcept;
+
+		static constexpr std::size_t SPINS_BEFORE_WITHDRAWAL = 128;
+
+	private:
+		std::vector<Slot> slots;
+
+		inline static char takenTag;
+	};
+
+	template <typename Node>
+	EliminationArray<Node>::EliminationArray(std::size_t width) :
+		slots(width > 0 ? width : 1)
+	{
+	}
+
+	template <typename Node>
+	bool EliminationArray<Node>::tryToHandOff(Node* node) noexcept
+	{
+		auto& slot = randomSlot();
+
+		if (Node* empty = nullptr;
+			!slot.offer.compare_exchange_strong(empty, node,
+				                                std::memory_order_release,
+				                                std::memory_order_relaxed))
+		{
+			return false;
+		}
+		else if (waitToBeTaken(slot))
+		{
+			slot.offer.store(nullptr, std::memory_order_relaxed);
+			return true;
+		}
+		else if (auto offered = node;
+			     slot.offer.compare_exchange_strong(offered, nullptr, std::memory_order_relaxed))
+		{
+			return false;
+		}
+		else
+		{
+			//taken just before the withdrawal
+			slot.offer.store(nullptr, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	template <typename Node>
+	bool EliminationArray<Node>::waitToBeTaken(Slot& slot) noexcept
+	{
+		for (std::size_t i = 0; i < SPINS_BEFORE_WITHDRAWAL; ++i)
+		{
+			if (slot.offer.load(std::memory_order_relaxed) == taken())
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <typename Node>
+	Node* EliminationArray<Node>::tryToTake() noexcept
+	{
+		auto& slot = randomSlot();
+		auto offer = slot.offer.load(std::memory_order_relaxed);
+
+		if (offer != nullptr && offer != taken() &&
+			slot.offer.compare_exchange_strong(offer, taken(),
+				                               std::memory_order_acquire,
+				                               std::memory_order_relaxed))
+		{
+			return offer;
+		}
+
+		return nullptr;
+	}
+
+	template <typename Node>
+	auto EliminationArray<Node>::randomSlot() noexcept -> Slot&
+	{
+		//xorshift, seeded differently in every thread
+		static thread_local auto state = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&state)) | 1u;
+
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		return slots[state % slots.size()];
+	}
+
+	template <typename Node>
+	inline Node* EliminationArray<Node>::taken() noexcept
+	{
+		return reinterpret_cast<Node*>(&takenTag);
+	}
+}
+
+#endif //__ELIMINATION_ARRAY_H_INCLUDED__
@@ -0,0 +1,55 @@
+#ifndef __ELIMINATION_BACKOFF_STACK_H_INCLUDED__
+#define __ELIMINATION_BACKOFF_STACK_H_INCLUDED__
+
+#include "LockFreeStack.h"
+#include "EliminationArray.h"
+#include <algorithm>
+#include <thread>
+
+namespace IDragnev::Multithreading
+{
+	//A LockFreeStack in which a push or a pop that fails its CAS on the head
+	//tries to meet an operation of the opposite kind in an elimination array
+	//instead of retrying right away. Matched pairs complete without touching
+	//the head, so throughput keeps growing with the number of threads.
+	template <typename T>
+	class EliminationBackoffStack
+	{
+	private:
+		using Stack = LockFreeStack<T>;
+		using Node = typename Stack::Node;
+		using RefCountedNodePtr = typename Stack::RefCountedNodePtr;
+
+	public:
+		using Chain = typename Stack::Chain;
+		using Batch = typename Stack::Batch;
+
+		EliminationBackoffStack();
+		explicit EliminationBackoffStack(std::size_t eliminationSlots);
+		EliminationBackoffStack(const EliminationBackoffStack&) = delete;
+		~EliminationBackoffStack() = default;
+
+		EliminationBackoffStack& operator=(const EliminationBackoffStack&) = delete;
+
+		template <typename... Args>
+		void emplace(Args&&... args);
+		void push(T&& item);
+		void push(const T& item);
+		std::optional<T> pop();
+		void pushChain(Chain&& chain) { stack.pushChain(std::move(chain)); }
+		Batch popAll() { return stack.popAll(); }
+
+	private:
+		template <typename... Args>
+		void doPush(Args&&... args);
+
+		static std::size_t defaultEliminationSlots() noexcept;
+
+	private:
+		Stack stack;
+		EliminationArray<Node> eliminationArray;
+	};
+}
+
+#include "EliminationBackoffStackImpl.hpp"
+#endif //__ELIMINATION_BACKOFF_STACK_H_INCLUDED__
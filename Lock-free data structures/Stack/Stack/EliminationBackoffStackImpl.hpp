@@ -0,0 +1,71 @@
+
+namespace IDragnev::Multithreading
+{
+	template <typename T>
+	EliminationBackoffStack<T>::EliminationBackoffStack() :
+		EliminationBackoffStack(defaultEliminationSlots())
+	{
+	}
+
+	template <typename T>
+	EliminationBackoffStack<T>::EliminationBackoffStack(std::size_t eliminationSlots) :
+		eliminationArray(eliminationSlots)
+	{
+	}
+
+	template <typename T>
+	inline std::size_t EliminationBackoffStack<T>::defaultEliminationSlots() noexcept
+	{
+		return std::max(std::thread::hardware_concurrency() / 2, 1u);
+	}
+
+	template <typename T>
+	template <typename... Args>
+	inline void EliminationBackoffStack<T>::emplace(Args&&... args)
+	{
+		doPush(std::forward<Args>(args)...);
+	}
+
+	template <typename T>
+	inline void EliminationBackoffStack<T>::push(const T& item)
+	{
+		doPush(item);
+	}
+
+	template <typename T>
+	inline void EliminationBackoffStack<T>::push(T&& item)
+	{
+		doPush(std::move(item));
+	}
+
+	template <typename T>
+	template <typename... Args>
+	void EliminationBackoffStack<T>::doPush(Args&&... args)
+	{
+		auto ptr = Stack::makeRefCountedNodePtr(std::forward<Args>(args)...);
+
+		while (!stack.tryToInsertAsHead(ptr) &&
+			   !eliminationArray.tryToHandOff(ptr.node))
+		{ }
+	}
+
+	template <typename T>
+	std::optional<T> EliminationBackoffStack<T>::pop()
+	{
+		auto oldHead = stack.head.load(std::memory_order_relaxed);
+		auto result = std::optional<T>{};
+
+		while (!stack.tryToPop(oldHead, result))
+		{
+			if (auto node = eliminationArray.tryToTake();
+				node != nullptr)
+			{
+				Stack::extractDataOf(node, result);
+				delete node;
+				break;
+			}
+		}
+
+		return result;
+	}
+}
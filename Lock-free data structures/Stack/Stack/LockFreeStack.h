@@ -3,16 +3,25 @@
 
 #define _ENABLE_ATOMIC_ALIGNMENT_FIX
 
+#include "Lock-free data structures\Backoff.h"
 #include <atomic>
+#include <cstdint>
+#include <iterator>
 #include <optional>
 #include <assert.h>
 
 namespace IDragnev::Multithreading
 {
 	template <typename T>
+	class EliminationBackoffStack;
+
+	//Backoff is called after every failed CAS on the head, see Backoff.h
+	template <typename T, typename Backoff = NoBackoff>
 	class LockFreeStack
 	{
 	private:
+		friend class EliminationBackoffStack<T>;
+
 		static_assert(std::is_nothrow_move_constructible_v<T>, 
 			          "LockFreeStack cannot guarantee exception safety for T unles it is nothrow move-constructible");
 		
@@ -42,6 +51,88 @@ namespace IDragnev::Multithreading
 		};
 
 	public:
+		//Items linked privately by one thread and then pushed
+		//all at once with pushChain. The last item added ends up on top.
+		class Chain
+		{
+		public:
+			Chain() = default;
+			Chain(Chain&& source) noexcept;
+			Chain(const Chain&) = delete;
+			~Chain();
+
+			Chain& operator=(Chain&& rhs) noexcept;
+			Chain& operator=(const Chain&) = delete;
+
+			template <typename... Args>
+			void emplace(Args&&... args);
+			void push(T&& item);
+			void push(const T& item);
+
+			bool isEmpty() const noexcept;
+
+		private:
+			friend class LockFreeStack;
+
+			void release() noexcept;
+			void clear() noexcept;
+
+		private:
+			RefCountedNodePtr first = { nullptr, 0 };
+			Node* last = nullptr;
+		};
+
+		//Items detached from the stack by popAll, top first.
+		//Other threads may still hold references to any of the nodes
+		//when they are detached, so each is released through its reference counts.
+		class Batch
+		{
+		public:
+			class Iterator
+			{
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = T;
+				using difference_type = std::ptrdiff_t;
+				using pointer = T*;
+				using reference = T&;
+
+				explicit Iterator(Node* node = nullptr) noexcept : node(node) { }
+
+				T& operator*() const noexcept { return node->data; }
+				T* operator->() const noexcept { return &node->data; }
+				Iterator& operator++() noexcept { node = node->next.node; return *this; }
+				Iterator operator++(int) noexcept { auto copy = *this; ++(*this); return copy; }
+
+				bool operator==(const Iterator& rhs) const noexcept { return node == rhs.node; }
+				bool operator!=(const Iterator& rhs) const noexcept { return node != rhs.node; }
+
+			private:
+				Node* node;
+			};
+
+			Batch() = default;
+			Batch(Batch&& source) noexcept;
+			Batch(const Batch&) = delete;
+			~Batch();
+
+			Batch& operator=(Batch&& rhs) noexcept;
+			Batch& operator=(const Batch&) = delete;
+
+			Iterator begin() const noexcept { return Iterator{ first.node }; }
+			Iterator end() const noexcept { return Iterator{}; }
+			bool isEmpty() const noexcept { return first.node == nullptr; }
+
+		private:
+			friend class LockFreeStack;
+
+			explicit Batch(RefCountedNodePtr first) noexcept;
+			void clear() noexcept;
+
+		private:
+			RefCountedNodePtr first = { nullptr, 0 };
+		};
+
 		LockFreeStack();
 		LockFreeStack(const LockFreeStack&) = delete;
 		~LockFreeStack();
@@ -53,13 +144,17 @@ namespace IDragnev::Multithreading
 		void push(T&& item);
 		void push(const T& item);
 		std::optional<T> pop();
+		void pushChain(Chain&& chain);
+		Batch popAll();
 
 	private:
 		template <typename... Args>
 		void doPush(Args&&... args);
 		void insertAsHead(RefCountedNodePtr ptr);
+		bool tryToInsertAsHead(RefCountedNodePtr ptr);
+		bool tryToPop(RefCountedNodePtr& oldHead, std::optional<T>& result);
 
-		static std::optional<T> extractDataOf(Node* node);
+		static void extractDataOf(Node* node, std::optional<T>& result);
 		static void updateRefCountAndFreeNodeIfNotReferenced(RefCountedNodePtr ptr);
 		static void synchronizeWithRefCountUpdateAndFree(Node* node);
 
@@ -73,5 +168,7 @@ namespace IDragnev::Multithreading
 	};
 }
 
+#include "ChainImpl.hpp"
+#include "BatchImpl.hpp"
 #include "LockFreeStackImpl.hpp"
 #endif //__LOCK_FREE_STACK__
\ No newline at end of file
@@ -1,120 +1,168 @@
 
 namespace IDragnev::Multithreading
 {
-	template <typename T>
-	LockFreeStack<T>::LockFreeStack() :
+	template <typename T, typename Backoff>
+	LockFreeStack<T, Backoff>::LockFreeStack() :
 		head({ nullptr, 0 })
 	{
 	}
 
-	template <typename T>
-	LockFreeStack<T>::~LockFreeStack()
+	template <typename T, typename Backoff>
+	LockFreeStack<T, Backoff>::~LockFreeStack()
 	{
-		decltype(pop()) extracted = std::nullopt;
-		do
-		{
-			extracted = pop();
-		} while (extracted != std::nullopt);
+		popAll();
 	}
 
-	template <typename T>
+	template <typename T, typename Backoff>
 	template <typename... Args>
-	inline void LockFreeStack<T>::emplace(Args&&... args)
+	inline void LockFreeStack<T, Backoff>::emplace(Args&&... args)
 	{
 		doPush(std::forward<Args>(args)...);
 	}
 	
-	template <typename T>
-	inline void LockFreeStack<T>::push(const T& item)
+	template <typename T, typename Backoff>
+	inline void LockFreeStack<T, Backoff>::push(const T& item)
 	{
 		doPush(item);
 	}
 
-	template <typename T>
-	inline void LockFreeStack<T>::push(T&& item)
+	template <typename T, typename Backoff>
+	inline void LockFreeStack<T, Backoff>::push(T&& item)
 	{
 		doPush(std::move(item));
 	}
 
-	template <typename T>
+	template <typename T, typename Backoff>
 	template <typename... Args>
-	void LockFreeStack<T>::doPush(Args&&... args)
+	void LockFreeStack<T, Backoff>::doPush(Args&&... args)
 	{
 		auto ptr = makeRefCountedNodePtr(std::forward<Args>(args)...);
 		insertAsHead(ptr);
 	}
 
-	template <typename T>
+	template <typename T, typename Backoff>
 	template <typename... Args>
-	auto LockFreeStack<T>::makeRefCountedNodePtr(Args&&... args) -> RefCountedNodePtr
+	auto LockFreeStack<T, Backoff>::makeRefCountedNodePtr(Args&&... args) -> RefCountedNodePtr
 	{
 		return RefCountedNodePtr{ new Node(std::forward<Args>(args)...) };
 	}
 
-	template <typename T>
-	void LockFreeStack<T>::insertAsHead(RefCountedNodePtr ptr)
+	template <typename T, typename Backoff>
+	void LockFreeStack<T, Backoff>::insertAsHead(RefCountedNodePtr ptr)
 	{
 		ptr.node->next = head.load(std::memory_order_relaxed);
-		while (!head.compare_exchange_weak(ptr.node->next, ptr,
-			                               std::memory_order_release,
-			                               std::memory_order_relaxed))
+		for (auto backoff = Backoff{};
+			 !head.compare_exchange_weak(ptr.node->next, ptr,
+				                         std::memory_order_release,
+				                         std::memory_order_relaxed);
+			 backoff())
 		{ }
 	}
 
-	template <typename T>
-	std::optional<T> LockFreeStack<T>::pop()
+	template <typename T, typename Backoff>
+	bool LockFreeStack<T, Backoff>::tryToInsertAsHead(RefCountedNodePtr ptr)
 	{
-		auto oldHead = head.load(std::memory_order_relaxed);
+		ptr.node->next = head.load(std::memory_order_relaxed);
+		return head.compare_exchange_weak(ptr.node->next, ptr,
+			                              std::memory_order_release,
+			                              std::memory_order_relaxed);
+	}
 
-		for (;;)
+	template <typename T, typename Backoff>
+	void LockFreeStack<T, Backoff>::pushChain(Chain&& chain)
+	{
+		if (chain.isEmpty())
 		{
-			oldHead = getHeadIncreasingItsRefCount(oldHead);
-			auto node = oldHead.node;
+			return;
+		}
 
-			if (!node)
-			{
-				return std::nullopt;
-			}
-			else if (head.compare_exchange_strong(oldHead, node->next, 
-				                                  std::memory_order_relaxed))
-			{
-				auto result = extractDataOf(node);
-				updateRefCountAndFreeNodeIfNotReferenced(oldHead);
+		auto last = chain.last;
+		last->next = head.load(std::memory_order_relaxed);
+		for (auto backoff = Backoff{};
+			 !head.compare_exchange_weak(last->next, chain.first,
+				                         std::memory_order_release,
+				                         std::memory_order_relaxed);
+			 backoff())
+		{ }
 
-				return result;
-			}
-			else if (auto oldCount = node->internalCount.fetch_sub(1, std::memory_order_relaxed);
-				     oldCount == 1)
-			{
-				synchronizeWithRefCountUpdateAndFree(node);
-			}
+		chain.release();
+	}
+
+	template <typename T, typename Backoff>
+	auto LockFreeStack<T, Backoff>::popAll() -> Batch
+	{
+		auto oldHead = head.exchange({ nullptr, 0 }, std::memory_order_acquire);
+		return Batch{ oldHead };
+	}
+
+	template <typename T, typename Backoff>
+	std::optional<T> LockFreeStack<T, Backoff>::pop()
+	{
+		auto oldHead = head.load(std::memory_order_relaxed);
+		auto result = std::optional<T>{};
+
+		for (auto backoff = Backoff{}; !tryToPop(oldHead, result); backoff())
+		{ }
+
+		return result;
+	}
+
+	//returns false if another thread changed the head meanwhile,
+	//otherwise result holds the popped item or nothing if the stack was empty
+	template <typename T, typename Backoff>
+	bool LockFreeStack<T, Backoff>::tryToPop(RefCountedNodePtr& oldHead, std::optional<T>& result)
+	{
+		oldHead = getHeadIncreasingItsRefCount(oldHead);
+		auto node = oldHead.node;
+
+		if (!node)
+		{
+			return true;
+		}
+		else if (head.compare_exchange_strong(oldHead, node->next, 
+			                                  std::memory_order_relaxed))
+		{
+			extractDataOf(node, result);
+			updateRefCountAndFreeNodeIfNotReferenced(oldHead);
+
+			return true;
 		}
+		else if (auto oldCount = node->internalCount.fetch_sub(1, std::memory_order_relaxed);
+			     oldCount == 1)
+		{
+			synchronizeWithRefCountUpdateAndFree(node);
+		}
+
+		return false;
 	}
 
-	template <typename T>
-	auto LockFreeStack<T>::getHeadIncreasingItsRefCount(RefCountedNodePtr oldHead) -> RefCountedNodePtr
+	template <typename T, typename Backoff>
+	auto LockFreeStack<T, Backoff>::getHeadIncreasingItsRefCount(RefCountedNodePtr oldHead) -> RefCountedNodePtr
 	{
 		RefCountedNodePtr result;
 
-		do
+		for (auto backoff = Backoff{}; ; backoff())
 		{
 			result = oldHead;
 			++result.externalCount;
-		} while (!head.compare_exchange_strong(oldHead, result,
-											   std::memory_order_acquire,
-											   std::memory_order_relaxed));
 
-		return result;
+			if (head.compare_exchange_strong(oldHead, result,
+				                             std::memory_order_acquire,
+				                             std::memory_order_relaxed))
+			{
+				return result;
+			}
+		}
 	}
 
-	template <typename T>
-	inline std::optional<T> LockFreeStack<T>::extractDataOf(Node* node)
+	template <typename T, typename Backoff>
+	inline void LockFreeStack<T, Backoff>::extractDataOf(Node* node, std::optional<T>& result)
 	{
-		return std::move(node->data);
+		result.emplace(std::move(node->data));
 	}
 
-	template <typename T>
-	void LockFreeStack<T>::updateRefCountAndFreeNodeIfNotReferenced(RefCountedNodePtr ptr)
+	template <typename T, typename Backoff>
+	void LockFreeStack<T, Backoff>::updateRefCountAndFreeNodeIfNotReferenced(RefCountedNodePtr ptr)
 	{
 		auto node = ptr.node;
 		auto increase = ptr.externalCount - 2;
@@ -126,8 +174,8 @@ namespace IDragnev::Multithreading
 		}
 	}
 
-	template <typename T>
-	inline void LockFreeStack<T>::synchronizeWithRefCountUpdateAndFree(Node* node)
+	template <typename T, typename Backoff>
+	inline void LockFreeStack<T, Backoff>::synchronizeWithRefCountUpdateAndFree(Node* node)
 	{
 		auto x = node->internalCount.load(std::memory_order_acquire);
 		delete node;
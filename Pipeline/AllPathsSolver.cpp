@@ -0,0 +1,169 @@
+#include "AllPathsSolver.h"
+#include "ParallelBacktracking.h"
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <iterator>
+#include <assert.h>
+
+namespace IDragnev::Multithreading
+{
+	namespace
+	{
+		using Alphabet = AllPathsSolver::Alphabet;
+
+		//the search tree of the paths from a single start, a move per branch;
+		//every thread has its own path and map of the cells on it
+		class PathsFrom
+		{
+		public:
+			struct State
+			{
+				std::size_t x;
+				std::size_t y;
+				BitGrid visited;
+				std::string moves;
+			};
+
+			using Choice = char;
+			using Solution = std::string;
+
+			PathsFrom(const Grid& labirinth, const Alphabet& alphabet, std::size_t x, std::size_t y) :
+				labirinth{ labirinth },
+				alphabet{ alphabet },
+				startX{ x },
+				startY{ y }
+			{
+			}
+
+			State makeState() const
+			{
+				auto state = State{ startX, startY, BitGrid(labirinth.getWidth(), labirinth.getHeight()), {} };
+				state.visited.set(startX, startY, 1);
+
+				return state;
+			}
+
+			//a path ends at the first end it reaches
+			void getChoices(const State& state, std::vector<Choice>& choices) const
+			{
+				if (isEnd(state.x, state.y))
+				{
+					return;
+				}
+
+				for (auto move : { 'U', 'D', 'L', 'R' })
+				{
+					auto x = state.x;
+					auto y = state.y;
+
+					if (step(x, y, move) && labirinth(x, y) != static_cast<Grid::Cell>(alphabet.wall) && state.visited(x, y) == 0)
+					{
+						choices.push_back(move);
+					}
+				}
+			}
+
+			void apply(State& state, Choice move) const
+			{
+				step(state.x, state.y, move);
+				state.visited.set(state.x, state.y, 1);
+				state.moves.push_back(move);
+			}
+
+			void undo(State& state, Choice move) const
+			{
+				state.visited.set(state.x, state.y, 0);
+				step(state.x, state.y, opposite(move));
+				state.moves.pop_back();
+			}
+
+			std::optional<Solution> getSolution(const State& state) const
+			{
+				if (isEnd(state.x, state.y))
+				{
+					return state.moves;
+				}
+
+				return std::nullopt;
+			}
+
+		private:
+			bool isEnd(std::size_t x, std::size_t y) const noexcept
+			{
+				return labirinth(x, y) == static_cast<Grid::Cell>(alphabet.end);
+			}
+
+			//returns false if the move leaves the labirinth
+			bool step(std::size_t& x, std::size_t& y, Choice move) const noexcept
+			{
+				switch (move)
+				{
+				case 'U': if (y == 0) { return false; } --y; break;
+				case 'D': if (y + 1 == labirinth.getHeight()) { return false; } ++y; break;
+				case 'L': if (x == 0) { return false; } --x; break;
+				default:  if (x + 1 == labirinth.getWidth()) { return false; } ++x; break;
+				}
+
+				return true;
+			}
+
+			static Choice opposite(Choice move) noexcept
+			{
+				switch (move)
+				{
+				case 'U': return 'D';
+				case 'D': return 'U';
+				case 'L': return 'R';
+				default:  return 'L';
+				}
+			}
+
+		private:
+			const Grid& labirinth;
+			Alphabet alphabet;
+			std::size_t startX;
+			std::size_t startY;
+		};
+	}
+
+	AllPathsSolver::AllPathsSolver(const Alphabet& alphabet, std::size_t threads, std::size_t maxPaths, std::size_t minParallelCells) :
+		alphabet{ alphabet },
+		threads{ threads },
+		maxPaths{ maxPaths },
+		minParallelCells{ minParallelCells }
+	{
+		assert(threads > 0);
+	}
+
+	auto AllPathsSolver::operator()(const Grid& labirinth) const -> Result
+	{
+		auto paths = std::vector<std::string>{};
+		auto isLarge = labirinth.getWidth() * labirinth.getHeight() >= minParallelCells;
+		auto searchThreads = isLarge ? threads : std::size_t{ 1 };
+
+		for (auto y = std::size_t{ 0 }; y < labirinth.getHeight(); ++y)
+		{
+			auto row = labirinth.row(y);
+
+			for (auto x = row.find(alphabet.start); x != row.npos && paths.size() < maxPaths; x = row.find(alphabet.start, x + 1))
+			{
+				auto search = ParallelBacktracking<PathsFrom>{ searchThreads, maxPaths - paths.size() };
+				auto found = search(PathsFrom{ labirinth, alphabet, x, y });
+
+				paths.insert(std::end(paths), std::make_move_iterator(std::begin(found)), std::make_move_iterator(std::end(found)));
+			}
+		}
+
+		std::sort(std::begin(paths), std::end(paths));
+
+		auto result = Result{};
+
+		for (auto& path : paths)
+		{
+			result.push_back(std::move(path));
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,43 @@
+#ifndef __ALL_PATHS_SOLVER_H_INCLUDED__
+#define __ALL_PATHS_SOLVER_H_INCLUDED__
+
+#include "LabirinthSolver.h"
+#include "BitParallelSolver.h"
+#include "Grid.h"
+
+namespace IDragnev::Multithreading
+{
+	//Finds every path from a start to an end of a labirinth which never
+	//visits a cell twice and ends at the first end it reaches, searching
+	//with several threads through ParallelBacktracking. The paths are
+	//written as those of BitParallelSolver and sorted. Their number grows
+	//exponentially with the open area, so at most maxPaths are returned;
+	//which of them, when there are more, depends on the threads.
+	//Labirinths of fewer than minParallelCells cells are searched by the
+	//calling thread alone, as starting the threads would cost more.
+	class AllPathsSolver
+	{
+	public:
+		using Result = LabirinthSolver::Result;
+		using Alphabet = BitParallelSolver::Alphabet;
+
+		static constexpr std::size_t MAX_PATHS = std::size_t{ 1 } << 16;
+		static constexpr std::size_t MIN_PARALLEL_CELLS = 64;
+
+		AllPathsSolver() = default;
+		explicit AllPathsSolver(const Alphabet& alphabet,
+			                    std::size_t threads = 1,
+			                    std::size_t maxPaths = MAX_PATHS,
+			                    std::size_t minParallelCells = MIN_PARALLEL_CELLS);
+
+		Result operator()(const Grid& labirinth) const;
+
+	private:
+		Alphabet alphabet;
+		std::size_t threads = 1;
+		std::size_t maxPaths = MAX_PATHS;
+		std::size_t minParallelCells = MIN_PARALLEL_CELLS;
+	};
+}
+
+#endif //__ALL_PATHS_SOLVER_H_INCLUDED__
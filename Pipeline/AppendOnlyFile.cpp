@@ -0,0 +1,111 @@
+#include "AppendOnlyFile.h"
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace IDragnev::Multithreading
+{
+#ifdef _WIN32
+	AppendOnlyFile::AppendOnlyFile(const std::string& filename) :
+		filename{ filename }
+	{
+		//without the other write rights every write goes to the end of the file
+		auto file = CreateFileA(filename.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			throw FailedToOpen{ filename };
+		}
+
+		handle = file;
+	}
+
+	void AppendOnlyFile::append(std::string_view bytes)
+	{
+		auto written = DWORD{ 0 };
+		if (!WriteFile(handle, bytes.data(), static_cast<DWORD>(bytes.size()), &written, nullptr) || written != bytes.size())
+		{
+			throw FailedToWrite{ filename };
+		}
+	}
+
+	void AppendOnlyFile::close() noexcept
+	{
+		if (handle != nullptr)
+		{
+			CloseHandle(handle);
+		}
+	}
+
+	void AppendOnlyFile::swap(AppendOnlyFile& other) noexcept
+	{
+		std::swap(filename, other.filename);
+		std::swap(handle, other.handle);
+	}
+
+	AppendOnlyFile::AppendOnlyFile(AppendOnlyFile&& source) noexcept :
+		filename{ std::move(source.filename) },
+		handle{ std::exchange(source.handle, nullptr) }
+	{
+	}
+#else
+	AppendOnlyFile::AppendOnlyFile(const std::string& filename) :
+		filename{ filename }
+	{
+		descriptor = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+		if (descriptor == -1)
+		{
+			throw FailedToOpen{ filename };
+		}
+	}
+
+	void AppendOnlyFile::append(std::string_view bytes)
+	{
+		if (::write(descriptor, bytes.data(), bytes.size()) != static_cast<ssize_t>(bytes.size()))
+		{
+			throw FailedToWrite{ filename };
+		}
+	}
+
+	void AppendOnlyFile::close() noexcept
+	{
+		if (descriptor != -1)
+		{
+			::close(descriptor);
+		}
+	}
+
+	void AppendOnlyFile::swap(AppendOnlyFile& other) noexcept
+	{
+		std::swap(filename, other.filename);
+		std::swap(descriptor, other.descriptor);
+	}
+
+	AppendOnlyFile::AppendOnlyFile(AppendOnlyFile&& source) noexcept :
+		filename{ std::move(source.filename) },
+		descriptor{ std::exchange(source.descriptor, -1) }
+	{
+	}
+#endif
+
+	AppendOnlyFile::~AppendOnlyFile()
+	{
+		close();
+	}
+
+	AppendOnlyFile& AppendOnlyFile::operator=(AppendOnlyFile&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			auto temp = AppendOnlyFile{ std::move(rhs) };
+			swap(temp);
+		}
+
+		return *this;
+	}
+}
@@ -0,0 +1,50 @@
+#ifndef __APPEND_ONLY_FILE_H_INCLUDED__
+#define __APPEND_ONLY_FILE_H_INCLUDED__
+
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+namespace IDragnev::Multithreading
+{
+	class FailedToWrite : public std::runtime_error
+	{
+	public:
+		FailedToWrite(const std::string& filename) :
+			std::runtime_error{ "Failed to write to " + filename }
+		{
+		}
+	};
+
+	//A file opened for appending only, created if it does not exist.
+	//Every append goes to the current end of the file with a single
+	//write, so appends from several threads or processes do not interleave.
+	class AppendOnlyFile
+	{
+	public:
+		AppendOnlyFile() = default;
+		explicit AppendOnlyFile(const std::string& filename);
+		AppendOnlyFile(AppendOnlyFile&& source) noexcept;
+		AppendOnlyFile(const AppendOnlyFile&) = delete;
+		~AppendOnlyFile();
+
+		AppendOnlyFile& operator=(AppendOnlyFile&& rhs) noexcept;
+		AppendOnlyFile& operator=(const AppendOnlyFile&) = delete;
+
+		void append(std::string_view bytes);
+
+	private:
+		void swap(AppendOnlyFile& other) noexcept;
+		void close() noexcept;
+
+	private:
+		std::string filename;
+#ifdef _WIN32
+		void* handle = nullptr;
+#else
+		int descriptor = -1;
+#endif
+	};
+}
+
+#endif //__APPEND_ONLY_FILE_H_INCLUDED__
@@ -0,0 +1,120 @@
+#include "CorpusGenerator.h"
+#include <fstream>
+#include <algorithm>
+#include <assert.h>
+
+namespace fs = std::filesystem;
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	CorpusGenerator::CorpusGenerator(std::uint64_t seed, CorpusAlphabet alphabet) :
+		state{ seed },
+		alphabet{ alphabet }
+	{
+	}
+
+	//splitmix64
+	std::uint64_t CorpusGenerator::next() noexcept
+	{
+		auto z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+		return z ^ (z >> 31);
+	}
+
+	std::size_t CorpusGenerator::below(std::size_t bound) noexcept
+	{
+		return static_cast<std::size_t>(next() % bound);
+	}
+
+	double CorpusGenerator::fraction() noexcept
+	{
+		return static_cast<double>(next() >> 11) * 0x1.0p-53;
+	}
+
+	std::vector<std::string> CorpusGenerator::makeLabirinth(const CorpusShape& shape)
+	{
+		assert(shape.width > 1 && shape.height > 0);
+
+		auto rows = std::vector<std::string>(shape.height, std::string(shape.width, alphabet.open));
+
+		for (auto& row : rows)
+		{
+			for (auto& cell : row)
+			{
+				if (fraction() < shape.wallDensity)
+				{
+					cell = alphabet.wall;
+				}
+			}
+		}
+
+		auto start = below(shape.height);
+		auto end = below(shape.height);
+
+		for (auto i = std::size_t{ 0 }; i < shape.paths; ++i)
+		{
+			carvePath(rows, start, end);
+		}
+
+		rows[start].front() = alphabet.start;
+		rows[end].back() = alphabet.end;
+
+		return rows;
+	}
+
+	//walks the columns from left to right, turning up or down
+	//to a random row in each, and ends on the row of the end
+	void CorpusGenerator::carvePath(std::vector<std::string>& rows, std::size_t from, std::size_t to)
+	{
+		const auto width = rows.front().size();
+		auto y = from;
+
+		for (auto x = std::size_t{ 0 }; x < width; ++x)
+		{
+			auto target = (x + 1 < width) ? below(rows.size()) : to;
+
+			for (; y != target; y += (y < target) ? 1 : -1)
+			{
+				rows[y][x] = alphabet.open;
+			}
+
+			rows[y][x] = alphabet.open;
+		}
+	}
+
+	//the digits of the file number in base fanout name its directories
+	fs::path CorpusGenerator::directoryOf(std::size_t file, const CorpusShape& shape)
+	{
+		auto result = fs::path{};
+
+		for (auto level = std::size_t{ 0 }; level < shape.depth; ++level)
+		{
+			result /= "d" + std::to_string(file % shape.fanout);
+			file /= shape.fanout;
+		}
+
+		return result;
+	}
+
+	std::uint64_t CorpusGenerator::write(const CorpusShape& shape, const fs::path& root)
+	{
+		auto total = std::uint64_t{ 0 };
+
+		for (auto i = std::size_t{ 0 }; i < shape.files; ++i)
+		{
+			auto directory = root / directoryOf(i, shape);
+			fs::create_directories(directory);
+
+			auto file = std::ofstream{ directory / ("l" + std::to_string(i) + ".txt"), std::ios::binary };
+			for (const auto& row : makeLabirinth(shape))
+			{
+				file << row << '\n';
+				total += row.size() + 1;
+			}
+		}
+
+		return total;
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef __CORPUS_GENERATOR_H_INCLUDED__
+#define __CORPUS_GENERATOR_H_INCLUDED__
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	struct CorpusShape
+	{
+		std::string name;
+		std::size_t files = 1000;
+		std::size_t width = 64;
+		std::size_t height = 64;
+		//the chance that a cell off the carved paths is a wall
+		double wallDensity = 0.3;
+		//the number of paths carved from the start to the end
+		std::size_t paths = 1;
+		//0 for a flat directory, otherwise the number of
+		//directory levels between the root and the files
+		std::size_t depth = 0;
+		std::size_t fanout = 8;
+	};
+
+	struct CorpusAlphabet
+	{
+		char wall = '#';
+		char open = '.';
+		char start = 'S';
+		char end = 'E';
+	};
+
+	//Writes labirinths of rows of equal length with a start in the first
+	//column, an end in the last one and the requested number of paths
+	//carved between them. The same seed gives the same corpus on every
+	//platform, as no standard distribution is used.
+	class CorpusGenerator
+	{
+	public:
+		explicit CorpusGenerator(std::uint64_t seed, CorpusAlphabet alphabet = {});
+
+		//returns the total size of the files written
+		std::uint64_t write(const CorpusShape& shape, const std::filesystem::path& root);
+		std::vector<std::string> makeLabirinth(const CorpusShape& shape);
+
+	private:
+		void carvePath(std::vector<std::string>& rows, std::size_t from, std::size_t to);
+		static std::filesystem::path directoryOf(std::size_t file, const CorpusShape& shape);
+
+		std::uint64_t next() noexcept;
+		std::size_t below(std::size_t bound) noexcept;
+		double fraction() noexcept;
+
+	private:
+		std::uint64_t state;
+		CorpusAlphabet alphabet;
+	};
+}
+
+#endif //__CORPUS_GENERATOR_H_INCLUDED__
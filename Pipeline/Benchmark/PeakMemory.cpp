@@ -0,0 +1,57 @@
+#include "PeakMemory.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <fstream>
+#include <string>
+#endif
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+#ifdef _WIN32
+	std::uint64_t peakResidentBytes()
+	{
+		auto counters = PROCESS_MEMORY_COUNTERS{};
+		GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+
+		return counters.PeakWorkingSetSize;
+	}
+
+	void resetPeakResidentBytes()
+	{
+	}
+#else
+	std::uint64_t peakResidentBytes()
+	{
+#ifdef __linux__
+		//VmHWM follows the resets, the rusage maximum does not
+		auto status = std::ifstream{ "/proc/self/status" };
+		for (auto line = std::string{}; std::getline(status, line); )
+		{
+			if (line.compare(0, 6, "VmHWM:") == 0)
+			{
+				return std::stoull(line.substr(6)) * 1024;
+			}
+		}
+#endif
+		auto usage = rusage{};
+		getrusage(RUSAGE_SELF, &usage);
+
+#ifdef __APPLE__
+		return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+		return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+	}
+
+	void resetPeakResidentBytes()
+	{
+#ifdef __linux__
+		std::ofstream{ "/proc/self/clear_refs" } << "5";
+#endif
+	}
+#endif
+}
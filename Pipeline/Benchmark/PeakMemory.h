@@ -0,0 +1,15 @@
+#ifndef __PEAK_MEMORY_H_INCLUDED__
+#define __PEAK_MEMORY_H_INCLUDED__
+
+#include <cstdint>
+
+namespace IDragnev::Multithreading::Benchmarking
+{
+	//The largest resident set of the process in bytes, since the start
+	//or since the last reset. Only Linux can reset it, elsewhere the
+	//reset does nothing and the peak is that of the whole process.
+	std::uint64_t peakResidentBytes();
+	void resetPeakResidentBytes();
+}
+
+#endif //__PEAK_MEMORY_H_INCLUDED__
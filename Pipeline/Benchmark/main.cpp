@@ -0,0 +1,168 @@
+#include "CorpusGenerator.h"
+#include "PeakMemory.h"
+#include "Pipeline\PipelinedLabirinthSolver.h"
+#include "Pipeline\PipelineMetrics.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+using namespace IDragnev::Multithreading::Benchmarking;
+using IDragnev::Multithreading::PipelinedLabirinthSolver;
+using IDragnev::Multithreading::PipelineMetrics;
+
+namespace fs = std::filesystem;
+
+struct Options
+{
+	std::uint64_t seed = 42;
+	//scales the number of files of every shape
+	double scale = 1.0;
+	std::size_t loaders = 1;
+	std::size_t solvers = std::max(std::thread::hardware_concurrency(), 1u);
+	PipelinedLabirinthSolver::Engine engine = PipelinedLabirinthSolver::Engine::labirinthSolver;
+	std::size_t searchThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	std::string directory = (fs::temp_directory_path() / "labirinth-corpus").string();
+	std::string only;
+	bool keep = false;
+};
+
+Options parse(int argc, char* argv[])
+{
+	auto options = Options{};
+
+	for (auto i = 1; i < argc; ++i)
+	{
+		auto argument = std::string{ argv[i] };
+		auto hasValue = i + 1 < argc;
+
+		if (argument == "--seed" && hasValue)                { options.seed = std::stoull(argv[++i]); }
+		else if (argument == "--scale" && hasValue)          { options.scale = std::stod(argv[++i]); }
+		else if (argument == "--loaders" && hasValue)        { options.loaders = std::stoul(argv[++i]); }
+		else if (argument == "--solvers" && hasValue)        { options.solvers = std::stoul(argv[++i]); }
+		else if (argument == "--directory" && hasValue)      { options.directory = argv[++i]; }
+		else if (argument == "--only" && hasValue)           { options.only = argv[++i]; }
+		else if (argument == "--bit-parallel")               { options.engine = PipelinedLabirinthSolver::Engine::bitParallel; }
+		else if (argument == "--all-paths")                  { options.engine = PipelinedLabirinthSolver::Engine::allPaths; }
+		else if (argument == "--search-threads" && hasValue) { options.searchThreads = std::stoul(argv[++i]); }
+		else if (argument == "--keep")                       { options.keep = true; }
+	}
+
+	return options;
+}
+
+//many small files stress the scanning and loading,
+//few large ones the solving and a single huge one
+//the search of a labirinth by several threads;
+//only the tiny ones are fit for enumerating all paths
+auto shapes(double scale)
+{
+	auto files = [scale](std::size_t count) { return std::max(static_cast<std::size_t>(count * scale), std::size_t{ 1 }); };
+
+	return std::vector<CorpusShape>{
+		{ "flat-tiny",     files(2000),    6,    6, 0.35, 1, 0, 8 },
+		{ "flat-small",    files(4000),   16,   16, 0.30, 1, 0, 8 },
+		{ "nested-small",  files(4000),   16,   16, 0.30, 1, 3, 8 },
+		{ "flat-medium",   files(1000),  128,  128, 0.30, 2, 0, 8 },
+		{ "flat-dense",    files(1000),  128,  128, 0.60, 1, 0, 8 },
+		{ "flat-open",     files(1000),  128,  128, 0.05, 4, 0, 8 },
+		{ "nested-large",  files(50),   1024, 1024, 0.30, 2, 2, 4 },
+		{ "single-huge",   files(1),    8192, 8192, 0.30, 2, 0, 8 }
+	};
+}
+
+struct Measurement
+{
+	std::uint64_t bytes = 0;
+	std::size_t solved = 0;
+	std::chrono::duration<double> elapsed{ 0 };
+	std::uint64_t peakResidentBytes = 0;
+	PipelineMetrics::Snapshot stages;
+};
+
+Measurement measure(const CorpusShape& shape, const fs::path& directory, const Options& options)
+{
+	auto metrics = PipelineMetrics{};
+	auto solverOptions = PipelinedLabirinthSolver::Options{};
+	solverOptions.loaders = options.loaders;
+	solverOptions.solvers = options.solvers;
+	solverOptions.ordering = PipelinedLabirinthSolver::Ordering::asSolved;
+	solverOptions.recursive = shape.depth > 0;
+	solverOptions.engine = options.engine;
+	solverOptions.searchThreads = options.searchThreads;
+	solverOptions.metrics = &metrics;
+
+	auto solver = PipelinedLabirinthSolver{ solverOptions };
+	auto result = Measurement{};
+
+	resetPeakResidentBytes();
+	auto start = std::chrono::steady_clock::now();
+	solver(directory.string(), [&result](auto) { ++result.solved; });
+	result.elapsed = std::chrono::steady_clock::now() - start;
+	result.peakResidentBytes = peakResidentBytes();
+	result.stages = metrics.snapshot();
+
+	return result;
+}
+
+void print(const CorpusShape& shape, const Measurement& m)
+{
+	auto seconds = std::max(m.elapsed.count(), 1e-9);
+
+	std::cout << std::left << std::setw(14) << shape.name << std::right
+		      << std::setw(7) << m.solved
+		      << std::setw(6) << shape.width << "x" << std::left << std::setw(6) << shape.height << std::right << " |"
+		      << std::fixed << std::setprecision(3)
+		      << std::setw(9) << seconds << " s |"
+		      << std::setprecision(1)
+		      << std::setw(10) << m.solved / seconds << " files/s |"
+		      << std::setw(8) << m.bytes / seconds / 1e6 << " MB/s |"
+		      << std::setw(8) << m.peakResidentBytes / 1e6 << " MB peak |";
+
+	for (const auto& stage : m.stages.stages)
+	{
+		std::cout << " " << stage.name << " " << std::setprecision(0) << stage.utilization * 100 << "%";
+	}
+
+	std::cout << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+	auto options = parse(argc, argv);
+	auto all = shapes(options.scale);
+
+	for (auto i = std::size_t{ 0 }; i < all.size(); ++i)
+	{
+		const auto& shape = all[i];
+		//every shape has its own seed, so that selecting
+		//some of them does not change the corpus of the others
+		auto generator = CorpusGenerator{ options.seed + i };
+
+		if (shape.name.find(options.only) == std::string::npos)
+		{
+			continue;
+		}
+
+		auto directory = fs::path{ options.directory } / shape.name;
+		fs::remove_all(directory);
+		auto bytes = generator.write(shape, directory);
+
+		auto measurement = measure(shape, directory, options);
+		measurement.bytes = bytes;
+		print(shape, measurement);
+
+		//the whole stage table only for a single selected shape
+		if (shape.name == options.only)
+		{
+			std::cout << measurement.stages;
+		}
+
+		if (!options.keep)
+		{
+			fs::remove_all(directory);
+		}
+	}
+}
@@ -0,0 +1,556 @@
+#include "BitParallelSolver.h"
+#include <algorithm>
+#include <utility>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <exception>
+#include <system_error>
+#include <assert.h>
+
+namespace IDragnev::Multithreading
+{
+	namespace
+	{
+		using Word = BitGrid::Word;
+		using Position = std::pair<std::size_t, std::size_t>;
+		using Positions = std::vector<Position>;
+		using Words = std::vector<std::size_t>;
+
+		//moves bit i of the lower half of a word to bit 2i
+		inline Word spreadLowHalf(Word bits) noexcept
+		{
+			bits &= 0x00000000FFFFFFFFULL;
+			bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFULL;
+			bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFULL;
+			bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+			bits = (bits | (bits << 2)) & 0x3333333333333333ULL;
+			bits = (bits | (bits << 1)) & 0x5555555555555555ULL;
+
+			return bits;
+		}
+
+		//the label of a cell is its level modulo 3, plus 1 to tell it from
+		//an unvisited cell; a word of cells covers two words of labels
+		inline std::pair<Word, Word> labelsOf(Word cells, std::size_t level) noexcept
+		{
+			const auto value = static_cast<Word>(level % 3 + 1);
+			return { spreadLowHalf(cells) * value, spreadLowHalf(cells >> 32) * value };
+		}
+
+		//the cells next to the frontier in a word: the words above and below
+		//as they are, and the word itself shifted by a cell both ways,
+		//carrying the bits crossing a word boundary
+		template <typename Load>
+		inline Word neighboursIn(std::size_t word, std::size_t stride, std::size_t words, Load frontier) noexcept
+		{
+			const auto column = word % stride;
+
+			auto toRight = (frontier(word) << 1) | ((column > 0) ? frontier(word - 1) >> 63 : 0);
+			auto toLeft = (frontier(word) >> 1) | ((column + 1 < stride) ? frontier(word + 1) << 63 : 0);
+			auto vertical = ((word >= stride) ? frontier(word - stride) : 0) |
+				            ((word + stride < words) ? frontier(word + stride) : 0);
+
+			return toRight | toLeft | vertical;
+		}
+
+		//only the words of the frontier and their neighbours can hold
+		//cells of the next level; a word to the side is only reached
+		//through the frontier cell at the edge of the word
+		template <typename Compute>
+		inline void forEachCandidate(std::size_t word, Word cells, std::size_t stride, std::size_t words, Compute compute)
+		{
+			auto column = word % stride;
+
+			compute(word);
+			if (column > 0 && (cells & 1) != 0)               { compute(word - 1); }
+			if (column + 1 < stride && (cells >> 63) != 0)    { compute(word + 1); }
+			if (word >= stride)                               { compute(word - stride); }
+			if (word + stride < words)                        { compute(word + stride); }
+		}
+
+		//The state shared by the threads of a single parallel search.
+		//The frontier of a level is kept in one of three bitmaps in turn:
+		//while a level reads the frontier of the previous one and fills the
+		//next, the threads clear the bitmap of the level before, so that it
+		//is empty when its turn comes again. Computing a word finds the cells
+		//next to the frontier and claims the unvisited ones with an atomic and;
+		//a word may be claimed in parts by several threads and then appears
+		//more than once in the next frontier, which only repeats some work.
+		class ParallelSearch
+		{
+		private:
+			using LockGuard = std::lock_guard<std::mutex>;
+			using UniqueLock = std::unique_lock<std::mutex>;
+			using AtomicWords = std::vector<std::atomic<Word>>;
+
+		public:
+			ParallelSearch(const BitGrid& open, const Positions& starts, Positions ends) :
+				width{ open.getWidth() },
+				height{ open.getHeight() },
+				stride{ open.getStride() },
+				labelStride{ TwoBitGrid(width, 1).getStride() },
+				words{ stride * height },
+				unvisited(words),
+				labels(labelStride * height),
+				pending{ std::move(ends) }
+			{
+				for (auto& bitmap : frontiers)
+				{
+					bitmap = AtomicWords(words);
+				}
+
+				for (auto i = std::size_t{ 0 }; i < words; ++i)
+				{
+					unvisited[i].store(open.rowWords(0)[i], std::memory_order_relaxed);
+				}
+
+				for (auto [x, y] : starts)
+				{
+					auto word = y * stride + x / 64;
+					auto bit = Word{ 1 } << (x % 64);
+
+					frontiers[0][word].fetch_or(bit, std::memory_order_relaxed);
+					unvisited[word].fetch_and(~bit, std::memory_order_relaxed);
+					labels[y * labelStride + x / 32].fetch_or(Word{ 1 } << (2 * (x % 32)), std::memory_order_relaxed);
+					frontier.push_back(word);
+				}
+
+				dropReachedEnds();
+			}
+
+			//the threads wait in run until the number of
+			//participants, the calling one included, is known
+			void start(std::size_t count)
+			{
+				{
+					auto lock = LockGuard(mutex);
+					participants = count;
+					shares.resize(count);
+				}
+
+				condition.notify_all();
+			}
+
+			void run(std::size_t participant)
+			{
+				auto done = false;
+
+				{
+					auto lock = UniqueLock(mutex);
+					condition.wait(lock, [this] { return participants != 0; });
+
+					if (participant >= participants)
+					{
+						return;
+					}
+
+					done = isDone();
+				}
+
+				for (; !done; done = arriveAndWait())
+				{
+					try
+					{
+						expandShare(participant);
+					}
+					catch (...)
+					{
+						fail(std::current_exception());
+					}
+				}
+			}
+
+			TwoBitGrid takeLabels()
+			{
+				if (error)
+				{
+					std::rethrow_exception(error);
+				}
+
+				auto result = TwoBitGrid(width, height);
+				auto target = result.rowWords(0);
+
+				for (auto i = std::size_t{ 0 }; i < labels.size(); ++i)
+				{
+					target[i] = labels[i].load(std::memory_order_relaxed);
+				}
+
+				return result;
+			}
+
+		private:
+			void expandShare(std::size_t participant)
+			{
+				auto& next = shares[participant];
+				const auto& current = frontiers[(level - 1) % 3];
+				auto& reached = frontiers[level % 3];
+				auto& stale = frontiers[(level + 1) % 3];
+
+				auto load = [&current](std::size_t word) { return current[word].load(std::memory_order_relaxed); };
+				auto compute = [this, &load, &reached, &next](std::size_t word)
+				{
+					auto candidates = neighboursIn(word, stride, words, load) & unvisited[word].load(std::memory_order_relaxed);
+					if (candidates == 0)
+					{
+						return;
+					}
+
+					if (auto claimed = unvisited[word].fetch_and(~candidates, std::memory_order_relaxed) & candidates; claimed != 0)
+					{
+						auto [low, high] = labelsOf(claimed, level);
+						auto y = word / stride;
+						auto column = word % stride;
+
+						reached[word].fetch_or(claimed, std::memory_order_relaxed);
+						labels[y * labelStride + 2 * column].fetch_or(low, std::memory_order_relaxed);
+						if (2 * column + 1 < labelStride)
+						{
+							labels[y * labelStride + 2 * column + 1].fetch_or(high, std::memory_order_relaxed);
+						}
+						next.push_back(word);
+					}
+				};
+
+				for (auto i : shareOf(frontier.size(), participant))
+				{
+					forEachCandidate(frontier[i], load(frontier[i]), stride, words, compute);
+				}
+
+				for (auto i : shareOf(previous.size(), participant))
+				{
+					stale[previous[i]].store(0, std::memory_order_relaxed);
+				}
+			}
+
+			//the indices of the items of a participant
+			struct Share
+			{
+				struct Iterator
+				{
+					std::size_t i;
+
+					std::size_t operator*() const noexcept { return i; }
+					Iterator& operator++() noexcept { ++i; return *this; }
+					bool operator!=(const Iterator& rhs) const noexcept { return i != rhs.i; }
+				};
+
+				Iterator begin() const noexcept { return { first }; }
+				Iterator end() const noexcept { return { last }; }
+
+				std::size_t first;
+				std::size_t last;
+			};
+
+			Share shareOf(std::size_t items, std::size_t participant) const noexcept
+			{
+				return { items * participant / participants, items * (participant + 1) / participants };
+			}
+
+			//the last thread to arrive joins the shares into the next frontier
+			//and moves on to the next level, the mutex orders the levels
+			bool arriveAndWait()
+			{
+				auto lock = UniqueLock(mutex);
+
+				if (++arrived == participants)
+				{
+					finishLevel();
+					arrived = 0;
+					++generation;
+					condition.notify_all();
+				}
+				else
+				{
+					auto current = generation;
+					condition.wait(lock, [this, current] { return generation != current; });
+				}
+
+				return isDone();
+			}
+
+			void finishLevel()
+			{
+				try
+				{
+					previous = std::move(frontier);
+					frontier.clear();
+
+					for (auto& share : shares)
+					{
+						frontier.insert(std::end(frontier), std::begin(share), std::end(share));
+						share.clear();
+					}
+
+					++level;
+					dropReachedEnds();
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+			}
+
+			void dropReachedEnds()
+			{
+				auto isReached = [this](const Position& p)
+				{
+					auto word = unvisited[p.second * stride + p.first / 64].load(std::memory_order_relaxed);
+					return ((word >> (p.first % 64)) & 1) == 0;
+				};
+
+				pending.erase(std::remove_if(std::begin(pending), std::end(pending), isReached), std::end(pending));
+			}
+
+			bool isDone() const noexcept
+			{
+				return error || frontier.empty() || pending.empty();
+			}
+
+			void fail(std::exception_ptr e)
+			{
+				auto lock = LockGuard(mutex);
+
+				if (!error)
+				{
+					error = e;
+				}
+			}
+
+		private:
+			const std::size_t width;
+			const std::size_t height;
+			const std::size_t stride;
+			const std::size_t labelStride;
+			const std::size_t words;
+			AtomicWords unvisited;
+			AtomicWords frontiers[3];
+			AtomicWords labels;
+			Words frontier;
+			Words previous;
+			std::vector<Words> shares;
+			Positions pending;
+			std::size_t level = 1;
+			std::size_t participants = 0;
+			std::size_t arrived = 0;
+			std::size_t generation = 0;
+			std::exception_ptr error;
+			std::mutex mutex;
+			std::condition_variable condition;
+		};
+	}
+
+	BitParallelSolver::Search::Search(BitGrid open) :
+		unvisited{ std::move(open) },
+		frontier(unvisited.getWidth(), unvisited.getHeight()),
+		next(unvisited.getWidth(), unvisited.getHeight()),
+		labels(unvisited.getWidth(), unvisited.getHeight())
+	{
+	}
+
+	BitParallelSolver::BitParallelSolver(const Alphabet& alphabet, std::size_t threads, std::size_t minParallelCells) :
+		alphabet{ alphabet },
+		threads{ threads },
+		minParallelCells{ minParallelCells }
+	{
+		assert(threads > 0);
+	}
+
+	auto BitParallelSolver::operator()(const Grid& labirinth) const -> Result
+	{
+		auto starts = find(labirinth, alphabet.start);
+		auto ends = find(labirinth, alphabet.end);
+
+		if (starts.empty() || ends.empty())
+		{
+			return {};
+		}
+
+		auto isLarge = labirinth.getWidth() * labirinth.getHeight() >= minParallelCells;
+		auto labels = (threads > 1 && isLarge) ? searchInParallel(openCells(labirinth), starts, ends) :
+			                                     search(openCells(labirinth), starts, ends);
+		auto result = Result{};
+
+		for (auto [x, y] : ends)
+		{
+			if (labels(x, y) != 0)
+			{
+				result.push_back(walkBack(labirinth, labels, { x, y }));
+			}
+		}
+
+		return result;
+	}
+
+	//the search stops once every end is reached
+	TwoBitGrid BitParallelSolver::search(BitGrid open, const Positions& starts, Positions ends)
+	{
+		auto search = Search{ std::move(open) };
+		auto frontier = Words{};
+
+		for (auto [x, y] : starts)
+		{
+			search.frontier.set(x, y, 1);
+			search.unvisited.set(x, y, 0);
+			search.labels.set(x, y, 1);
+			frontier.push_back(y * search.frontier.getStride() + x / 64);
+		}
+
+		auto isReached = [&search](const Position& p) { return search.unvisited(p.first, p.second) == 0; };
+
+		for (auto level = std::size_t{ 1 }; !frontier.empty(); ++level)
+		{
+			ends.erase(std::remove_if(std::begin(ends), std::end(ends), isReached), std::end(ends));
+			if (ends.empty())
+			{
+				break;
+			}
+
+			frontier = expand(search, frontier, level);
+		}
+
+		return std::move(search.labels);
+	}
+
+	//if a helper cannot be started the search goes on without it
+	TwoBitGrid BitParallelSolver::searchInParallel(BitGrid open, const Positions& starts, Positions ends) const
+	{
+		auto search = ParallelSearch{ open, starts, std::move(ends) };
+		//the search has its own atomic copy of the open cells
+		open = BitGrid{};
+
+		auto helpers = std::vector<std::future<void>>{};
+		helpers.reserve(threads - 1);
+
+		try
+		{
+			for (auto i = std::size_t{ 1 }; i < threads; ++i)
+			{
+				helpers.push_back(std::async(std::launch::async, [&search, i] { search.run(i); }));
+			}
+		}
+		catch (std::system_error&)
+		{
+		}
+
+		//the calling thread is one of the participants
+		search.start(helpers.size() + 1);
+		search.run(0);
+
+		for (auto& h : helpers)
+		{
+			h.wait();
+		}
+
+		return search.takeLabels();
+	}
+
+	BitGrid BitParallelSolver::openCells(const Grid& labirinth) const
+	{
+		auto result = BitGrid(labirinth.getWidth(), labirinth.getHeight());
+
+		for (auto y = std::size_t{ 0 }; y < labirinth.getHeight(); ++y)
+		{
+			auto cells = labirinth.rowBytes(y);
+			auto words = result.rowWords(y);
+
+			for (auto x = std::size_t{ 0 }; x < labirinth.getWidth(); ++x)
+			{
+				words[x / 64] |= Word{ cells[x] != static_cast<Grid::Cell>(alphabet.wall) } << (x % 64);
+			}
+		}
+
+		return result;
+	}
+
+	auto BitParallelSolver::find(const Grid& labirinth, char cell) const -> Positions
+	{
+		auto result = Positions{};
+
+		for (auto y = std::size_t{ 0 }; y < labirinth.getHeight(); ++y)
+		{
+			auto row = labirinth.row(y);
+
+			for (auto x = row.find(cell); x != row.npos; x = row.find(cell, x + 1))
+			{
+				result.emplace_back(x, y);
+			}
+		}
+
+		return result;
+	}
+
+	auto BitParallelSolver::expand(Search& search, const Words& frontier, std::size_t level) -> Words
+	{
+		const auto stride = search.frontier.getStride();
+		const auto words = stride * search.frontier.getHeight();
+		const auto cells = search.frontier.rowWords(0);
+		auto next = Words{};
+
+		for (auto word : frontier)
+		{
+			forEachCandidate(word, cells[word], stride, words, [&](std::size_t w) { compute(search, w, level, next); });
+		}
+
+		for (auto word : frontier)
+		{
+			cells[word] = 0;
+		}
+
+		std::swap(search.frontier, search.next);
+		return next;
+	}
+
+	//computing a word again on the same level finds nothing,
+	//as its cells are no longer unvisited
+	void BitParallelSolver::compute(Search& search, std::size_t word, std::size_t level, Words& next)
+	{
+		const auto stride = search.frontier.getStride();
+		const auto words = stride * search.frontier.getHeight();
+		const auto frontier = search.frontier.rowWords(0);
+		auto& unvisited = search.unvisited.rowWords(0)[word];
+		auto load = [frontier](std::size_t w) { return frontier[w]; };
+
+		if (auto reached = neighboursIn(word, stride, words, load) & unvisited; reached != 0)
+		{
+			unvisited &= ~reached;
+			search.next.rowWords(0)[word] |= reached;
+			label(search.labels, word / stride, word % stride, reached, level);
+			next.push_back(word);
+		}
+	}
+
+	void BitParallelSolver::label(TwoBitGrid& labels, std::size_t y, std::size_t column, Word cells, std::size_t level) noexcept
+	{
+		auto [low, high] = labelsOf(cells, level);
+		auto words = labels.rowWords(y);
+
+		words[2 * column] |= low;
+
+		if (2 * column + 1 < labels.getStride())
+		{
+			words[2 * column + 1] |= high;
+		}
+	}
+
+	//steps to the neighbour whose label is one level lower until a start
+	std::string BitParallelSolver::walkBack(const Grid& labirinth, const TwoBitGrid& labels, Position end) const
+	{
+		auto [x, y] = end;
+		auto moves = std::string{};
+
+		while (labirinth(x, y) != static_cast<Grid::Cell>(alphabet.start))
+		{
+			auto previous = static_cast<TwoBitGrid::Cell>(labels(x, y) == 1 ? 3 : labels(x, y) - 1);
+
+			if (y > 0 && labels(x, y - 1) == previous)                             { --y; moves += 'D'; }
+			else if (y + 1 < labirinth.getHeight() && labels(x, y + 1) == previous) { ++y; moves += 'U'; }
+			else if (x > 0 && labels(x - 1, y) == previous)                         { --x; moves += 'R'; }
+			else                                                                    { ++x; moves += 'L'; }
+		}
+
+		std::reverse(std::begin(moves), std::end(moves));
+		return moves;
+	}
+}
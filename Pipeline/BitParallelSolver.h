@@ -0,0 +1,88 @@
+#ifndef __BIT_PARALLEL_SOLVER_H_INCLUDED__
+#define __BIT_PARALLEL_SOLVER_H_INCLUDED__
+
+#include "LabirinthSolver.h"
+#include "Grid.h"
+#include <vector>
+#include <string>
+#include <utility>
+
+namespace IDragnev::Multithreading
+{
+	//Finds a shortest path from the starts to every reachable end of a
+	//labirinth with a breadth-first search that moves 64 cells of the
+	//frontier at a time: the open cells are packed into bits, a word per
+	//64 cells of a row, and a level of the search is a few shifts and masks
+	//per word next to the frontier. Only the words holding frontier cells
+	//are kept, so a level costs as much as its frontier, not the grid.
+	//Every cell is labelled with its distance modulo 3, which is enough to
+	//walk back from an end, as neighbouring cells differ in distance by one.
+	//A path is the moves from a start to an end, one of U, D, L, R per step,
+	//and the paths follow the order of their ends, row by row.
+	//That is a result of its own, not the one of LabirinthSolver: a single
+	//shortest path per end instead of every path, written as moves,
+	//so the two cannot stand in for each other.
+	//Labirinths of at least minParallelCells cells are searched by several
+	//threads, a level at a time: each expands its share of the frontier into
+	//a buffer of its own, claiming cells from a shared atomic bitmap of the
+	//unvisited ones, and the buffers are joined into the next frontier.
+	class BitParallelSolver
+	{
+	public:
+		using Result = LabirinthSolver::Result;
+
+		struct Alphabet
+		{
+			char wall = '#';
+			char start = 'S';
+			char end = 'E';
+		};
+
+		//below that the levels are too short to share between threads
+		static constexpr std::size_t MIN_PARALLEL_CELLS = std::size_t{ 1 } << 24;
+
+		BitParallelSolver() = default;
+		explicit BitParallelSolver(const Alphabet& alphabet, std::size_t threads = 1, std::size_t minParallelCells = MIN_PARALLEL_CELLS);
+
+		Result operator()(const Grid& labirinth) const;
+
+	private:
+		using Word = BitGrid::Word;
+		using Position = std::pair<std::size_t, std::size_t>;
+		using Positions = std::vector<Position>;
+
+		//the indices of the words of a BitGrid that hold frontier cells,
+		//y * stride + x / 64 for a cell (x, y)
+		using Words = std::vector<std::size_t>;
+
+		//the state of a search between its levels
+		struct Search
+		{
+			explicit Search(BitGrid open);
+
+			//the open cells not reached yet
+			BitGrid unvisited;
+			BitGrid frontier;
+			BitGrid next;
+			TwoBitGrid labels;
+		};
+
+		static TwoBitGrid search(BitGrid open, const Positions& starts, Positions ends);
+		TwoBitGrid searchInParallel(BitGrid open, const Positions& starts, Positions ends) const;
+
+		BitGrid openCells(const Grid& labirinth) const;
+		Positions find(const Grid& labirinth, char cell) const;
+		std::string walkBack(const Grid& labirinth, const TwoBitGrid& labels, Position end) const;
+
+		static Words expand(Search& search, const Words& frontier, std::size_t level);
+		static void compute(Search& search, std::size_t word, std::size_t level, Words& next);
+		static void label(TwoBitGrid& labels, std::size_t y, std::size_t column, Word cells, std::size_t level) noexcept;
+
+	private:
+		Alphabet alphabet;
+		std::size_t threads = 1;
+		std::size_t minParallelCells = MIN_PARALLEL_CELLS;
+	};
+}
+
+#endif //__BIT_PARALLEL_SOLVER_H_INCLUDED__
@@ -1,12 +1,29 @@
 #include "DirectoryTextFilesFlatIterator.h"
-#include "Functional.h"
 #include <assert.h>
 #include <algorithm>
+#include <iterator>
 
 namespace fs = std::filesystem;
 
 namespace IDragnev::Multithreading
 {
+	bool hasTextExtension(const fs::path& path) noexcept
+	{
+		static constexpr fs::path::value_type extension[] = { '.', 't', 'x', 't' };
+		static constexpr auto extensionLength = std::size(extension);
+
+		const auto& name = path.native();
+		if (name.size() <= extensionLength ||
+			!std::equal(std::cend(name) - extensionLength, std::cend(name), std::cbegin(extension)))
+		{
+			return false;
+		}
+
+		//a file named just ".txt" has no extension
+		auto beforeExtension = name[name.size() - extensionLength - 1];
+		return beforeExtension != '/' && beforeExtension != fs::path::preferred_separator;
+	}
+
 	DirectoryTextFilesFlatIterator::DirectoryTextFilesFlatIterator(const std::string& path)
 	{
 		try
@@ -22,10 +39,7 @@ namespace IDragnev::Multithreading
 
 	void DirectoryTextFilesFlatIterator::toNextTextFile()
 	{
-		using Functional::matches;
-		using namespace std::string_literals;
-
-		auto isTextFile = matches(".txt"s, [](const auto& entry) { return entry.path().extension(); });
+		auto isTextFile = [](const auto& entry) { return hasTextExtension(entry.path()); };
 		current = std::find_if(current, end, isTextFile);
 	}
 
@@ -15,6 +15,10 @@ namespace IDragnev::Multithreading
 		}
 	};
 
+	//compares the end of the native path in place,
+	//without building an extension path
+	bool hasTextExtension(const std::filesystem::path& path) noexcept;
+
 	class DirectoryTextFilesFlatIterator
 	{
 	private:
@@ -0,0 +1,235 @@
+#include "DirectoryWatcher.h"
+#include "DirectoryTextFilesFlatIterator.h"
+#include <iostream>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace IDragnev::Multithreading
+{
+#ifdef __linux__
+	DirectoryWatcher::DirectoryWatcher(const std::string& path, bool recursive) :
+		recursive{ recursive }
+	{
+		if (auto errorCode = std::error_code{};
+			!fs::is_directory(path, errorCode))
+		{
+			throw NoSuchDirectory{ path };
+		}
+
+		notifications = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (notifications == -1 || ::pipe2(stopPipe, O_NONBLOCK | O_CLOEXEC) == -1)
+		{
+			close();
+			throw std::system_error{ errno, std::generic_category(), "Failed to watch " + path };
+		}
+
+		try
+		{
+			addWatch(path);
+
+			if (recursive)
+			{
+				auto errorCode = std::error_code{};
+				for (auto it = fs::recursive_directory_iterator{ path, errorCode }; !errorCode && it != fs::recursive_directory_iterator{}; it.increment(errorCode))
+				{
+					if (auto entryError = std::error_code{}; it->is_directory(entryError) && !it->is_symlink(entryError))
+					{
+						addWatch(it->path());
+					}
+				}
+			}
+		}
+		catch (...)
+		{
+			close();
+			throw;
+		}
+	}
+
+	DirectoryWatcher::~DirectoryWatcher()
+	{
+		close();
+	}
+
+	void DirectoryWatcher::close() noexcept
+	{
+		for (auto descriptor : { notifications, stopPipe[0], stopPipe[1] })
+		{
+			if (descriptor != -1)
+			{
+				::close(descriptor);
+			}
+		}
+
+		notifications = stopPipe[0] = stopPipe[1] = -1;
+	}
+
+	void DirectoryWatcher::addWatch(const fs::path& directory)
+	{
+		static constexpr auto EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+
+		auto watch = ::inotify_add_watch(notifications, directory.c_str(), EVENTS);
+		if (watch == -1)
+		{
+			throw NoSuchDirectory{ directory.string() };
+		}
+
+		directories[watch] = directory;
+	}
+
+	//the stop pipe is polled together with inotify,
+	//so a blocked watcher wakes up as soon as stop writes to it
+	void DirectoryWatcher::operator()(const Callback& onTextFile)
+	{
+		pollfd descriptors[] = { { notifications, POLLIN, 0 }, { stopPipe[0], POLLIN, 0 } };
+
+		for (;;)
+		{
+			if (::poll(descriptors, 2, -1) == -1)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				throw std::system_error{ errno, std::generic_category(), "Failed to wait for file events" };
+			}
+
+			if (descriptors[1].revents != 0)
+			{
+				auto byte = char{};
+				while (::read(stopPipe[0], &byte, 1) == 1) { }
+				return;
+			}
+
+			if (!handleEvents(onTextFile))
+			{
+				return;
+			}
+		}
+	}
+
+	bool DirectoryWatcher::handleEvents(const Callback& onTextFile)
+	{
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		for (;;)
+		{
+			auto length = ::read(notifications, buffer, sizeof(buffer));
+			if (length <= 0)
+			{
+				return true;
+			}
+
+			for (auto p = buffer; p < buffer + length; )
+			{
+				const auto& event = *reinterpret_cast<const inotify_event*>(p);
+				p += sizeof(inotify_event) + event.len;
+
+				if (event.mask & IN_Q_OVERFLOW)
+				{
+					std::cerr << "Too many file events, some files were missed\n";
+					continue;
+				}
+				else if (event.mask & IN_IGNORED)
+				{
+					directories.erase(event.wd);
+					continue;
+				}
+
+				auto directory = directories.find(event.wd);
+				if (directory == std::end(directories) || event.len == 0)
+				{
+					continue;
+				}
+
+				auto path = directory->second / event.name;
+
+				if (event.mask & IN_ISDIR)
+				{
+					if (recursive && (event.mask & (IN_CREATE | IN_MOVED_TO)) && !watchNewDirectory(path, onTextFile))
+					{
+						return false;
+					}
+				}
+				else if ((event.mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) && hasTextExtension(path))
+				{
+					if (!onTextFile(path.string()))
+					{
+						return false;
+					}
+				}
+			}
+		}
+	}
+
+	bool DirectoryWatcher::watchNewDirectory(const fs::path& directory, const Callback& onTextFile)
+	{
+		try
+		{
+			addWatch(directory);
+		}
+		catch (NoSuchDirectory&)
+		{
+			//already removed again
+			return true;
+		}
+
+		auto errorCode = std::error_code{};
+		for (auto it = fs::directory_iterator{ directory, errorCode }; !errorCode && it != fs::directory_iterator{}; it.increment(errorCode))
+		{
+			auto entryError = std::error_code{};
+
+			if (it->is_symlink(entryError))
+			{
+				continue;
+			}
+			else if (it->is_directory(entryError))
+			{
+				if (!watchNewDirectory(it->path(), onTextFile))
+				{
+					return false;
+				}
+			}
+			else if (hasTextExtension(it->path()) && !onTextFile(it->path().string()))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void DirectoryWatcher::stop() noexcept
+	{
+		auto byte = char{ 1 };
+		[[maybe_unused]] auto written = ::write(stopPipe[1], &byte, 1);
+	}
+#else
+	DirectoryWatcher::DirectoryWatcher(const std::string&, bool recursive) :
+		recursive{ recursive }
+	{
+		throw WatchingUnsupported{};
+	}
+
+	DirectoryWatcher::~DirectoryWatcher() = default;
+
+	void DirectoryWatcher::operator()(const Callback&)
+	{
+		throw WatchingUnsupported{};
+	}
+
+	void DirectoryWatcher::stop() noexcept
+	{
+	}
+#endif
+}
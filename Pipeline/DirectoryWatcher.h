@@ -0,0 +1,60 @@
+#ifndef __DIRECTORY_WATCHER_H_INCLUDED__
+#define __DIRECTORY_WATCHER_H_INCLUDED__
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <stdexcept>
+
+namespace IDragnev::Multithreading
+{
+	class WatchingUnsupported : public std::runtime_error
+	{
+	public:
+		WatchingUnsupported() :
+			std::runtime_error{ "Watching directories is only supported on Linux" }
+		{
+		}
+	};
+
+	//Reports the text files written into a directory (and optionally its
+	//subdirectories) from the moment it is created: a file is reported
+	//every time it is closed after writing or moved into the directory.
+	//Built on inotify, so it is available on Linux only.
+	class DirectoryWatcher
+	{
+	public:
+		//returning false stops the watching
+		using Callback = std::function<bool(std::string)>;
+
+		//throws NoSuchDirectory if path is not a directory
+		//and WatchingUnsupported on other systems
+		explicit DirectoryWatcher(const std::string& path, bool recursive = false);
+		DirectoryWatcher(const DirectoryWatcher&) = delete;
+		~DirectoryWatcher();
+
+		DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+		//blocks and reports files until stop is called
+		void operator()(const Callback& onTextFile);
+		//may be called from any thread and from signal handlers
+		void stop() noexcept;
+
+	private:
+		void close() noexcept;
+		void addWatch(const std::filesystem::path& directory);
+		//the files written before a new subdirectory was
+		//watched would be missed otherwise
+		bool watchNewDirectory(const std::filesystem::path& directory, const Callback& onTextFile);
+		bool handleEvents(const Callback& onTextFile);
+
+	private:
+		bool recursive;
+		int notifications = -1;
+		int stopPipe[2] = { -1, -1 };
+		std::unordered_map<int, std::filesystem::path> directories;
+	};
+}
+
+#endif //__DIRECTORY_WATCHER_H_INCLUDED__
@@ -0,0 +1,157 @@
+#ifndef __GRID_H_INCLUDED__
+#define __GRID_H_INCLUDED__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <iterator>
+#include <stdexcept>
+
+namespace IDragnev::Multithreading
+{
+	class RaggedRows : public std::invalid_argument
+	{
+	public:
+		RaggedRows() :
+			std::invalid_argument{ "All rows of a grid must have the same length" }
+		{
+		}
+	};
+
+	//A rectangular grid of cells in one contiguous buffer.
+	//Every row starts on a 64-bit word boundary. Cells of 1 or 2 bits
+	//are packed into the words of their row: cell x is in word
+	//x / CELLS_PER_WORD, starting at bit (x % CELLS_PER_WORD) * BITS.
+	//Cells of 8 bits are the bytes of the row, so these grids can
+	//also be read as rows of characters.
+	template <unsigned BITS>
+	class BasicGrid
+	{
+	private:
+		static_assert(BITS == 1 || BITS == 2 || BITS == 8, "A cell takes 1, 2 or 8 bits");
+
+	public:
+		using Cell = std::uint8_t;
+		using Word = std::uint64_t;
+
+		static constexpr unsigned BITS_PER_CELL = BITS;
+		static constexpr std::size_t CELLS_PER_WORD = 64 / BITS;
+		static constexpr Cell CELL_MASK = static_cast<Cell>((1u << BITS) - 1);
+
+		class RowIterator;
+		class Rows;
+
+	public:
+		BasicGrid() = default;
+		BasicGrid(std::size_t width, std::size_t height, Cell fill = 0);
+		BasicGrid(BasicGrid&& source) = default;
+		BasicGrid(const BasicGrid& source) = default;
+		~BasicGrid() = default;
+
+		BasicGrid& operator=(BasicGrid&& rhs) = default;
+		BasicGrid& operator=(const BasicGrid& rhs) = default;
+
+		//builds a grid from a range of rows (strings or string views),
+		//encode maps every character to a cell;
+		//throws RaggedRows if the rows differ in length
+		template <typename ForwardIterator, typename Encode>
+		static BasicGrid fromRows(ForwardIterator first, ForwardIterator last, Encode encode);
+		//the characters are stored as they are, only for grids of 8-bit cells
+		template <typename ForwardIterator>
+		static BasicGrid fromRows(ForwardIterator first, ForwardIterator last);
+
+		Cell operator()(std::size_t x, std::size_t y) const noexcept;
+		void set(std::size_t x, std::size_t y, Cell value) noexcept;
+
+		std::size_t getWidth() const noexcept { return width; }
+		std::size_t getHeight() const noexcept { return height; }
+		//the distance between two rows in words
+		std::size_t getStride() const noexcept { return stride; }
+
+		const Word* rowWords(std::size_t y) const noexcept { return words.data() + y * stride; }
+		Word* rowWords(std::size_t y) noexcept { return words.data() + y * stride; }
+
+		const Cell* rowBytes(std::size_t y) const noexcept { return reinterpret_cast<const Cell*>(rowWords(y)); }
+		Cell* rowBytes(std::size_t y) noexcept { return reinterpret_cast<Cell*>(rowWords(y)); }
+
+		//the rows as character views, only for grids of 8-bit cells
+		Rows rows() const noexcept;
+		std::string_view row(std::size_t y) const noexcept;
+
+	private:
+		static std::size_t strideFor(std::size_t width) noexcept;
+
+	private:
+		std::size_t width = 0;
+		std::size_t height = 0;
+		std::size_t stride = 0;
+		std::vector<Word> words;
+	};
+
+	//a random-access iterator over the rows of a BasicGrid<8>
+	template <unsigned BITS>
+	class BasicGrid<BITS>::RowIterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = std::string_view;
+
+		RowIterator() = default;
+		RowIterator(const BasicGrid* grid, std::size_t y) noexcept : grid{ grid }, y{ y } { }
+
+		reference operator*() const noexcept { return grid->row(y); }
+		reference operator[](difference_type n) const noexcept { return grid->row(y + n); }
+
+		RowIterator& operator++() noexcept { ++y; return *this; }
+		RowIterator& operator--() noexcept { --y; return *this; }
+		RowIterator operator++(int) noexcept { auto old = *this; ++y; return old; }
+		RowIterator operator--(int) noexcept { auto old = *this; --y; return old; }
+		RowIterator& operator+=(difference_type n) noexcept { y += n; return *this; }
+		RowIterator& operator-=(difference_type n) noexcept { y -= n; return *this; }
+
+		friend RowIterator operator+(RowIterator it, difference_type n) noexcept { return it += n; }
+		friend RowIterator operator+(difference_type n, RowIterator it) noexcept { return it += n; }
+		friend RowIterator operator-(RowIterator it, difference_type n) noexcept { return it -= n; }
+		friend difference_type operator-(const RowIterator& lhs, const RowIterator& rhs) noexcept
+		{
+			return static_cast<difference_type>(lhs.y) - static_cast<difference_type>(rhs.y);
+		}
+
+		friend bool operator==(const RowIterator& lhs, const RowIterator& rhs) noexcept { return lhs.y == rhs.y; }
+		friend bool operator!=(const RowIterator& lhs, const RowIterator& rhs) noexcept { return lhs.y != rhs.y; }
+		friend bool operator<(const RowIterator& lhs, const RowIterator& rhs) noexcept { return lhs.y < rhs.y; }
+		friend bool operator>(const RowIterator& lhs, const RowIterator& rhs) noexcept { return lhs.y > rhs.y; }
+		friend bool operator<=(const RowIterator& lhs, const RowIterator& rhs) noexcept { return lhs.y <= rhs.y; }
+		friend bool operator>=(const RowIterator& lhs, const RowIterator& rhs) noexcept { return lhs.y >= rhs.y; }
+
+	private:
+		const BasicGrid* grid = nullptr;
+		std::size_t y = 0;
+	};
+
+	template <unsigned BITS>
+	class BasicGrid<BITS>::Rows
+	{
+	public:
+		explicit Rows(const BasicGrid& grid) noexcept : grid{ &grid } { }
+
+		RowIterator begin() const noexcept { return { grid, 0 }; }
+		RowIterator end() const noexcept { return { grid, grid->getHeight() }; }
+		std::size_t size() const noexcept { return grid->getHeight(); }
+
+	private:
+		const BasicGrid* grid;
+	};
+
+	using Grid = BasicGrid<8>;
+	using TwoBitGrid = BasicGrid<2>;
+	using BitGrid = BasicGrid<1>;
+}
+
+#include "GridImpl.hpp"
+#endif //__GRID_H_INCLUDED__
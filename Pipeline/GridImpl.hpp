@@ -0,0 +1,124 @@
+#include <assert.h>
+#include <algorithm>
+
+namespace IDragnev::Multithreading
+{
+	template <unsigned BITS>
+	inline std::size_t BasicGrid<BITS>::strideFor(std::size_t width) noexcept
+	{
+		return (width + CELLS_PER_WORD - 1) / CELLS_PER_WORD;
+	}
+
+	template <unsigned BITS>
+	BasicGrid<BITS>::BasicGrid(std::size_t width, std::size_t height, Cell fill) :
+		width{ width },
+		height{ height },
+		stride{ strideFor(width) },
+		words(stride * height)
+	{
+		if (fill != 0)
+		{
+			for (auto y = std::size_t{ 0 }; y < height; ++y)
+			{
+				for (auto x = std::size_t{ 0 }; x < width; ++x)
+				{
+					set(x, y, fill);
+				}
+			}
+		}
+	}
+
+	template <unsigned BITS>
+	template <typename ForwardIterator, typename Encode>
+	BasicGrid<BITS> BasicGrid<BITS>::fromRows(ForwardIterator first, ForwardIterator last, Encode encode)
+	{
+		auto height = static_cast<std::size_t>(std::distance(first, last));
+		auto width = (height > 0) ? std::size(*first) : 0;
+		auto result = BasicGrid(width, height);
+
+		for (auto y = std::size_t{ 0 }; first != last; ++first, ++y)
+		{
+			const auto& row = *first;
+			if (std::size(row) != width)
+			{
+				throw RaggedRows{};
+			}
+
+			if constexpr (BITS == 8)
+			{
+				std::transform(std::begin(row), std::end(row), result.rowBytes(y), encode);
+			}
+			else
+			{
+				auto x = std::size_t{ 0 };
+				for (auto c : row)
+				{
+					result.set(x++, y, encode(c));
+				}
+			}
+		}
+
+		return result;
+	}
+
+	template <unsigned BITS>
+	template <typename ForwardIterator>
+	inline BasicGrid<BITS> BasicGrid<BITS>::fromRows(ForwardIterator first, ForwardIterator last)
+	{
+		static_assert(BITS == 8, "Grids of packed cells need an encoding of the characters");
+		return fromRows(first, last, [](char c) { return static_cast<Cell>(c); });
+	}
+
+	template <unsigned BITS>
+	inline auto BasicGrid<BITS>::operator()(std::size_t x, std::size_t y) const noexcept -> Cell
+	{
+		assert(x < width && y < height);
+
+		if constexpr (BITS == 8)
+		{
+			return rowBytes(y)[x];
+		}
+		else
+		{
+			auto word = rowWords(y)[x / CELLS_PER_WORD];
+			auto shift = (x % CELLS_PER_WORD) * BITS;
+
+			return static_cast<Cell>((word >> shift) & CELL_MASK);
+		}
+	}
+
+	template <unsigned BITS>
+	inline void BasicGrid<BITS>::set(std::size_t x, std::size_t y, Cell value) noexcept
+	{
+		assert(x < width && y < height);
+
+		if constexpr (BITS == 8)
+		{
+			rowBytes(y)[x] = value;
+		}
+		else
+		{
+			auto& word = rowWords(y)[x / CELLS_PER_WORD];
+			auto shift = (x % CELLS_PER_WORD) * BITS;
+
+			word &= ~(Word{ CELL_MASK } << shift);
+			word |= Word{ static_cast<Cell>(value & CELL_MASK) } << shift;
+		}
+	}
+
+	template <unsigned BITS>
+	inline std::string_view BasicGrid<BITS>::row(std::size_t y) const noexcept
+	{
+		static_assert(BITS == 8, "Only grids of 8-bit cells have character rows");
+		assert(y < height);
+
+		return { reinterpret_cast<const char*>(rowBytes(y)), width };
+	}
+
+	template <unsigned BITS>
+	inline auto BasicGrid<BITS>::rows() const noexcept -> Rows
+	{
+		static_assert(BITS == 8, "Only grids of 8-bit cells have character rows");
+		return Rows{ *this };
+	}
+}
@@ -0,0 +1,138 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace IDragnev::Multithreading
+{
+	//the descriptors are closed right after mapping,
+	//the mapping itself keeps the file contents alive
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::string& filename)
+	{
+		auto file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			throw FailedToOpen{ filename };
+		}
+
+		auto fileSize = LARGE_INTEGER{};
+		if (!GetFileSizeEx(file, &fileSize))
+		{
+			CloseHandle(file);
+			throw FailedToOpen{ filename };
+		}
+
+		//an empty file cannot be mapped
+		if (fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr)
+		{
+			throw FailedToOpen{ filename };
+		}
+
+		auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+		if (view == nullptr)
+		{
+			throw FailedToOpen{ filename };
+		}
+
+		data = static_cast<const char*>(view);
+		size = static_cast<std::size_t>(fileSize.QuadPart);
+	}
+
+	void MappedFile::unmap() noexcept
+	{
+		if (data != nullptr)
+		{
+			UnmapViewOfFile(data);
+		}
+	}
+#else
+	MappedFile::MappedFile(const std::string& filename)
+	{
+		auto file = ::open(filename.c_str(), O_RDONLY);
+		if (file == -1)
+		{
+			throw FailedToOpen{ filename };
+		}
+
+		struct stat status;
+		if (::fstat(file, &status) == -1)
+		{
+			::close(file);
+			throw FailedToOpen{ filename };
+		}
+
+		//an empty file cannot be mapped
+		if (status.st_size == 0)
+		{
+			::close(file);
+			return;
+		}
+
+		auto view = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		::close(file);
+		if (view == MAP_FAILED)
+		{
+			throw FailedToOpen{ filename };
+		}
+
+		//the file is read once from start to end
+		::madvise(view, status.st_size, MADV_SEQUENTIAL);
+
+		data = static_cast<const char*>(view);
+		size = static_cast<std::size_t>(status.st_size);
+	}
+
+	void MappedFile::unmap() noexcept
+	{
+		if (data != nullptr)
+		{
+			::munmap(const_cast<char*>(data), size);
+		}
+	}
+#endif
+
+	MappedFile::MappedFile(MappedFile&& source) noexcept :
+		data{ std::exchange(source.data, nullptr) },
+		size{ std::exchange(source.size, 0) }
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		unmap();
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			auto temp = MappedFile{ std::move(rhs) };
+			swap(temp);
+		}
+
+		return *this;
+	}
+
+	void MappedFile::swap(MappedFile& other) noexcept
+	{
+		std::swap(data, other.data);
+		std::swap(size, other.size);
+	}
+}
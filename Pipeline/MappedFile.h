@@ -0,0 +1,46 @@
+#ifndef __MAPPED_FILE_H_INCLUDED__
+#define __MAPPED_FILE_H_INCLUDED__
+
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+namespace IDragnev::Multithreading
+{
+	class FailedToOpen : public std::runtime_error
+	{
+	public:
+		FailedToOpen(const std::string& filename) :
+			std::runtime_error{ "Failed to open " + filename }
+		{
+		}
+	};
+
+	//A read-only view of a whole file mapped into memory.
+	//The contents stay valid for as long as the object owns the mapping,
+	//moving it does not move the mapped bytes.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::string& filename);
+		MappedFile(MappedFile&& source) noexcept;
+		MappedFile(const MappedFile&) = delete;
+		~MappedFile();
+
+		MappedFile& operator=(MappedFile&& rhs) noexcept;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		std::string_view getContents() const noexcept { return { data, size }; }
+
+	private:
+		void swap(MappedFile& other) noexcept;
+		void unmap() noexcept;
+
+	private:
+		const char* data = nullptr;
+		std::size_t size = 0;
+	};
+}
+
+#endif //__MAPPED_FILE_H_INCLUDED__
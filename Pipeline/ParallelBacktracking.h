@@ -0,0 +1,122 @@
+#ifndef __PARALLEL_BACKTRACKING_H_INCLUDED__
+#define __PARALLEL_BACKTRACKING_H_INCLUDED__
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <optional>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+
+namespace IDragnev::Multithreading
+{
+	//Runs a depth-first backtracking search with several threads.
+	//The Problem describes the search tree:
+	//    using State = ...;     the partial solution a thread extends and shrinks
+	//    using Choice = ...;    a branch taken from a state
+	//    using Solution = ...;
+	//    State makeState() const;                                  the root
+	//    void getChoices(const State&, std::vector<Choice>&) const; appends the branches
+	//    void apply(State&, const Choice&) const;
+	//    void undo(State&, const Choice&) const;                    reverts apply
+	//    std::optional<Solution> getSolution(const State&) const;
+	//Every thread keeps a state of its own and the choices which led to it.
+	//The work is split on demand: a thread out of work asks for some and the
+	//next busy thread to notice gives away the oldest branch it has not
+	//explored yet, as the choices from the root to it, the branch nearest
+	//the root being the largest. The solutions found by every thread are
+	//joined once the whole tree is searched, in no particular order.
+	template <typename Problem>
+	class ParallelBacktracking
+	{
+	public:
+		using State = typename Problem::State;
+		using Choice = typename Problem::Choice;
+		using Solution = typename Problem::Solution;
+		using Solutions = std::vector<Solution>;
+
+		//the search stops once maxSolutions are found
+		explicit ParallelBacktracking(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()),
+			                          std::size_t maxSolutions = std::numeric_limits<std::size_t>::max());
+
+		Solutions operator()(const Problem& problem) const;
+
+	private:
+		//the choices leading from the root to an unexplored branch
+		using Task = std::vector<Choice>;
+
+		class Search;
+
+	private:
+		std::size_t threads;
+		std::size_t maxSolutions;
+	};
+
+	//the state shared by the threads of a single search
+	template <typename Problem>
+	class ParallelBacktracking<Problem>::Search
+	{
+	private:
+		using LockGuard = std::lock_guard<std::mutex>;
+		using UniqueLock = std::unique_lock<std::mutex>;
+
+		//the branches of a node of the tree and the next one to take
+		struct Frame
+		{
+			std::vector<Choice> choices;
+			std::size_t next = 0;
+
+			bool isExhausted() const noexcept { return next == choices.size(); }
+		};
+
+	public:
+		Search(const Problem& problem, std::size_t maxSolutions);
+		Search(const Search&) = delete;
+		~Search() = default;
+
+		Search& operator=(const Search&) = delete;
+
+		//returns the solutions found by the calling thread
+		Solutions run();
+		void rethrowError() const;
+
+	private:
+		//kept by a thread from one task to the next
+		struct Buffers
+		{
+			std::vector<Choice> path;
+			std::vector<Frame> frames;
+		};
+
+		std::optional<Task> nextTask();
+		void finishTask();
+		void explore(const Task& task, Buffers& buffers, Solutions& solutions);
+		void enter(const State& state, std::vector<Frame>& frames, std::size_t& depth) const;
+		void record(const State& state, Solutions& solutions);
+		bool takeRequest() noexcept;
+		bool donate(Buffers& buffers, std::size_t depth, std::size_t prefix);
+		void stop(std::exception_ptr e = nullptr);
+
+	private:
+		const Problem& problem;
+		const std::size_t maxSolutions;
+		std::atomic<std::size_t> found = 0;
+		std::atomic<bool> stopped = false;
+		//the tasks asked for and not given yet
+		std::atomic<std::size_t> requests = 0;
+		std::mutex mutex;
+		std::condition_variable tasksAvailable;
+		std::deque<Task> tasks;
+		std::size_t busy = 0;
+		bool isOver = false;
+		std::exception_ptr error;
+	};
+}
+
+#include "ParallelBacktrackingImpl.hpp"
+#endif //__PARALLEL_BACKTRACKING_H_INCLUDED__
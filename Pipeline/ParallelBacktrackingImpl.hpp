@@ -0,0 +1,278 @@
+#include <future>
+#include <iterator>
+#include <system_error>
+#include <assert.h>
+
+namespace IDragnev::Multithreading
+{
+	template <typename Problem>
+	ParallelBacktracking<Problem>::ParallelBacktracking(std::size_t threads, std::size_t maxSolutions) :
+		threads{ threads },
+		maxSolutions{ maxSolutions }
+	{
+		assert(threads > 0);
+	}
+
+	//if a helper cannot be started the search goes on without it
+	template <typename Problem>
+	auto ParallelBacktracking<Problem>::operator()(const Problem& problem) const -> Solutions
+	{
+		auto search = Search{ problem, maxSolutions };
+		auto helpers = std::vector<std::future<Solutions>>{};
+		helpers.reserve(threads - 1);
+
+		try
+		{
+			for (auto i = std::size_t{ 1 }; i < threads; ++i)
+			{
+				helpers.push_back(std::async(std::launch::async, [&search] { return search.run(); }));
+			}
+		}
+		catch (std::system_error&)
+		{
+		}
+
+		//the calling thread is one of the searchers
+		auto result = search.run();
+
+		for (auto& h : helpers)
+		{
+			auto solutions = h.get();
+			result.insert(std::end(result), std::make_move_iterator(std::begin(solutions)), std::make_move_iterator(std::end(solutions)));
+		}
+
+		search.rethrowError();
+
+		return result;
+	}
+
+	template <typename Problem>
+	ParallelBacktracking<Problem>::Search::Search(const Problem& problem, std::size_t maxSolutions) :
+		problem{ problem },
+		maxSolutions{ maxSolutions },
+		tasks{ Task{} }
+	{
+	}
+
+	template <typename Problem>
+	auto ParallelBacktracking<Problem>::Search::run() -> Solutions
+	{
+		auto solutions = Solutions{};
+		auto buffers = Buffers{};
+
+		while (auto task = nextTask())
+		{
+			try
+			{
+				explore(*task, buffers, solutions);
+			}
+			catch (...)
+			{
+				stop(std::current_exception());
+			}
+
+			finishTask();
+		}
+
+		return solutions;
+	}
+
+	template <typename Problem>
+	void ParallelBacktracking<Problem>::Search::rethrowError() const
+	{
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+
+	//the search is over once no task is left and no thread is
+	//busy with one, as only a busy thread can give away more
+	template <typename Problem>
+	auto ParallelBacktracking<Problem>::Search::nextTask() -> std::optional<Task>
+	{
+		auto lock = UniqueLock(mutex);
+		auto hasAsked = false;
+
+		while (!isOver)
+		{
+			if (!tasks.empty())
+			{
+				auto task = std::move(tasks.front());
+				tasks.pop_front();
+				++busy;
+
+				return task;
+			}
+
+			if (busy == 0)
+			{
+				isOver = true;
+				tasksAvailable.notify_all();
+				break;
+			}
+
+			if (!hasAsked)
+			{
+				requests.fetch_add(1, std::memory_order_relaxed);
+				hasAsked = true;
+			}
+
+			tasksAvailable.wait(lock);
+		}
+
+		return std::nullopt;
+	}
+
+	template <typename Problem>
+	void ParallelBacktracking<Problem>::Search::finishTask()
+	{
+		auto lock = LockGuard(mutex);
+
+		if (--busy == 0 && tasks.empty())
+		{
+			isOver = true;
+			tasksAvailable.notify_all();
+		}
+	}
+
+	//the frame at index k holds the branches of the node at depth
+	//prefix + k, reached by the first prefix + k choices of the path
+	template <typename Problem>
+	void ParallelBacktracking<Problem>::Search::explore(const Task& task, Buffers& buffers, Solutions& solutions)
+	{
+		auto& [path, frames] = buffers;
+		auto state = problem.makeState();
+		auto depth = std::size_t{ 0 };
+
+		path.assign(std::begin(task), std::end(task));
+		for (const auto& choice : path)
+		{
+			problem.apply(state, choice);
+		}
+
+		const auto prefix = path.size();
+		record(state, solutions);
+		enter(state, frames, depth);
+
+		while (depth > 0 && !stopped.load(std::memory_order_relaxed))
+		{
+			if (takeRequest() && !donate(buffers, depth, prefix))
+			{
+				requests.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			auto& frame = frames[depth - 1];
+
+			if (frame.isExhausted())
+			{
+				if (--depth > 0)
+				{
+					problem.undo(state, path.back());
+					path.pop_back();
+				}
+
+				continue;
+			}
+
+			path.push_back(frame.choices[frame.next++]);
+			problem.apply(state, path.back());
+			record(state, solutions);
+			enter(state, frames, depth);
+		}
+	}
+
+	//the frames are reused, so that their choices keep their storage
+	template <typename Problem>
+	void ParallelBacktracking<Problem>::Search::enter(const State& state, std::vector<Frame>& frames, std::size_t& depth) const
+	{
+		if (frames.size() == depth)
+		{
+			frames.emplace_back();
+		}
+
+		auto& frame = frames[depth++];
+		frame.choices.clear();
+		frame.next = 0;
+		problem.getChoices(state, frame.choices);
+	}
+
+	template <typename Problem>
+	void ParallelBacktracking<Problem>::Search::record(const State& state, Solutions& solutions)
+	{
+		if (auto solution = problem.getSolution(state))
+		{
+			auto count = found.fetch_add(1, std::memory_order_relaxed);
+
+			if (count < maxSolutions)
+			{
+				solutions.push_back(std::move(*solution));
+			}
+
+			if (count + 1 >= maxSolutions)
+			{
+				stop();
+			}
+		}
+	}
+
+	template <typename Problem>
+	bool ParallelBacktracking<Problem>::Search::takeRequest() noexcept
+	{
+		auto pending = requests.load(std::memory_order_relaxed);
+
+		while (pending > 0)
+		{
+			if (requests.compare_exchange_weak(pending, pending - 1, std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//gives away the last branch of the frame nearest the root
+	//which has any left, returns false if there is none
+	template <typename Problem>
+	bool ParallelBacktracking<Problem>::Search::donate(Buffers& buffers, std::size_t depth, std::size_t prefix)
+	{
+		auto& [path, frames] = buffers;
+		auto last = std::begin(frames) + depth;
+		auto frame = std::find_if_not(std::begin(frames), last, [](const Frame& f) { return f.isExhausted(); });
+
+		if (frame == last)
+		{
+			return false;
+		}
+
+		auto k = static_cast<std::size_t>(frame - std::begin(frames));
+		auto task = Task(std::begin(path), std::begin(path) + prefix + k);
+		task.push_back(std::move(frame->choices.back()));
+		frame->choices.pop_back();
+
+		{
+			auto lock = LockGuard(mutex);
+			tasks.push_back(std::move(task));
+		}
+
+		tasksAvailable.notify_one();
+		return true;
+	}
+
+	template <typename Problem>
+	void ParallelBacktracking<Problem>::Search::stop(std::exception_ptr e)
+	{
+		stopped.store(true, std::memory_order_relaxed);
+
+		auto lock = LockGuard(mutex);
+
+		if (e && !error)
+		{
+			error = e;
+		}
+
+		isOver = true;
+		tasksAvailable.notify_all();
+	}
+}
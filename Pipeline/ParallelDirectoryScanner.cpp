@@ -0,0 +1,198 @@
+#include "ParallelDirectoryScanner.h"
+#include "DirectoryTextFilesFlatIterator.h"
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <vector>
+#include <optional>
+#include <atomic>
+#include <exception>
+#include <assert.h>
+
+namespace fs = std::filesystem;
+
+namespace IDragnev::Multithreading
+{
+	namespace
+	{
+		//the state shared by the threads of a single scan
+		class Walk
+		{
+		private:
+			using LockGuard = std::lock_guard<std::mutex>;
+			using UniqueLock = std::unique_lock<std::mutex>;
+			using Callback = ParallelDirectoryScanner::Callback;
+
+		public:
+			Walk(fs::path root, const Callback& onTextFile) :
+				onTextFile{ onTextFile },
+				pending{ std::move(root) }
+			{
+			}
+
+			//the walk is over once no directory is pending and
+			//none is being visited, as only a visit can add more
+			void run()
+			{
+				while (auto directory = nextDirectory())
+				{
+					try
+					{
+						visit(*directory);
+					}
+					catch (...)
+					{
+						fail(std::current_exception());
+					}
+
+					finishVisit();
+				}
+			}
+
+			void rethrowError() const
+			{
+				if (error)
+				{
+					std::rethrow_exception(error);
+				}
+			}
+
+		private:
+			std::optional<fs::path> nextDirectory()
+			{
+				auto lock = UniqueLock(mutex);
+				condition.wait(lock, [this] { return !pending.empty() || busy == 0 || stopped.load(); });
+
+				if (stopped.load() || pending.empty())
+				{
+					return std::nullopt;
+				}
+
+				auto result = std::move(pending.back());
+				pending.pop_back();
+				++busy;
+
+				return result;
+			}
+
+			void visit(const fs::path& directory)
+			{
+				auto errorCode = std::error_code{};
+				auto end = fs::directory_iterator{};
+
+				for (auto it = fs::directory_iterator{ directory, errorCode };
+					 !errorCode && it != end && !stopped.load();
+					 it.increment(errorCode))
+				{
+					const auto& entry = *it;
+					auto entryError = std::error_code{};
+
+					if (entry.is_symlink(entryError))
+					{
+						continue;
+					}
+					else if (entry.is_directory(entryError))
+					{
+						addPending(entry.path());
+					}
+					else if (hasTextExtension(entry.path()) && !onTextFile(entry.path().string()))
+					{
+						stop();
+					}
+				}
+			}
+
+			void addPending(const fs::path& directory)
+			{
+				{
+					auto lock = LockGuard(mutex);
+					pending.push_back(directory);
+				}
+
+				condition.notify_one();
+			}
+
+			void finishVisit()
+			{
+				auto isLast = false;
+
+				{
+					auto lock = LockGuard(mutex);
+					isLast = (--busy == 0) && pending.empty();
+				}
+
+				if (isLast)
+				{
+					condition.notify_all();
+				}
+			}
+
+			void fail(std::exception_ptr e)
+			{
+				{
+					auto lock = LockGuard(mutex);
+					if (!error)
+					{
+						error = e;
+					}
+				}
+
+				stop();
+			}
+
+			void stop()
+			{
+				{
+					auto lock = LockGuard(mutex);
+					stopped = true;
+				}
+
+				condition.notify_all();
+			}
+
+		private:
+			const Callback& onTextFile;
+			std::mutex mutex;
+			std::condition_variable condition;
+			std::vector<fs::path> pending;
+			std::size_t busy = 0;
+			//also read by the visits without the lock
+			std::atomic<bool> stopped = false;
+			std::exception_ptr error;
+		};
+	}
+
+	ParallelDirectoryScanner::ParallelDirectoryScanner(std::size_t threads) :
+		threads{ threads }
+	{
+		assert(threads > 0);
+	}
+
+	void ParallelDirectoryScanner::operator()(const std::string& path, const Callback& onTextFile) const
+	{
+		if (auto errorCode = std::error_code{}; 
+			!fs::is_directory(path, errorCode))
+		{
+			throw NoSuchDirectory{ path };
+		}
+
+		auto walk = Walk{ path, onTextFile };
+		auto helpers = std::vector<std::future<void>>{};
+		helpers.reserve(threads - 1);
+
+		//the calling thread is one of the walkers
+		for (auto i = 1u; i < threads; ++i)
+		{
+			helpers.push_back(std::async(std::launch::async, [&walk] { walk.run(); }));
+		}
+
+		walk.run();
+
+		for (auto& h : helpers)
+		{
+			h.wait();
+		}
+
+		walk.rethrowError();
+	}
+}
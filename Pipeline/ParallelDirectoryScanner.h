@@ -0,0 +1,35 @@
+#ifndef __PARALLEL_DIRECTORY_SCANNER_H_INCLUDED__
+#define __PARALLEL_DIRECTORY_SCANNER_H_INCLUDED__
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <algorithm>
+
+namespace IDragnev::Multithreading
+{
+	//Finds the text files of a whole directory tree. The subdirectories
+	//are walked by several threads at once and every file is reported as
+	//soon as it is found, so consumers can start before the walk is over.
+	//Subdirectories that cannot be opened and symbolic links are skipped.
+	class ParallelDirectoryScanner
+	{
+	public:
+		//called from several threads at once,
+		//returning false stops the scan
+		using Callback = std::function<bool(std::string)>;
+
+		explicit ParallelDirectoryScanner(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()));
+		~ParallelDirectoryScanner() = default;
+
+		//throws NoSuchDirectory if path is not a directory and
+		//rethrows the first exception thrown by onTextFile
+		void operator()(const std::string& path, const Callback& onTextFile) const;
+
+	private:
+		std::size_t threads;
+	};
+}
+
+#endif //__PARALLEL_DIRECTORY_SCANNER_H_INCLUDED__
@@ -0,0 +1,110 @@
+#include "Pipeline.h"
+#include <future>
+
+namespace IDragnev::Multithreading::Detail
+{
+	void PipelineState::addChannel(std::function<void()> close)
+	{
+		auto lock = LockGuard(mutex);
+		channelClosers.push_back(std::move(close));
+	}
+
+	void PipelineState::fail(std::exception_ptr e)
+	{
+		{
+			auto lock = LockGuard(mutex);
+			if (!error)
+			{
+				error = e;
+			}
+		}
+
+		cancel();
+	}
+
+	void PipelineState::cancel()
+	{
+		cancelled.store(true);
+
+		auto lock = LockGuard(mutex);
+		for (auto& close : channelClosers)
+		{
+			close();
+		}
+	}
+
+	void PipelineState::rethrowError() const
+	{
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+
+	Stage makeStage(StatePtr state, std::size_t parallelism, std::function<void()> work, std::function<void()> finish, StageMetrics* metrics)
+	{
+		auto remaining = std::make_shared<std::atomic<std::size_t>>(parallelism);
+
+		auto worker = [state, remaining, work, finish, metrics]() mutable
+		{
+			PipelineMetrics::setCurrentStage(metrics);
+
+			try
+			{
+				work();
+			}
+			catch (...)
+			{
+				state->fail(std::current_exception());
+			}
+
+			PipelineMetrics::setCurrentStage(nullptr);
+
+			if (remaining->fetch_sub(1) == 1)
+			{
+				finish();
+			}
+		};
+
+		return { parallelism, std::move(worker) };
+	}
+
+	void runStages(PipelineState& state, const Stages& stages)
+	{
+		auto workers = std::vector<std::future<void>>{};
+		auto metrics = state.getMetrics();
+
+		if (metrics != nullptr)
+		{
+			metrics->start();
+		}
+
+		try
+		{
+			for (const auto& stage : stages)
+			{
+				for (auto i = 0u; i < stage.parallelism; ++i)
+				{
+					workers.push_back(std::async(std::launch::async, stage.work));
+				}
+			}
+		}
+		catch (...)
+		{
+			//the stages that did start must not wait for the ones that did not
+			state.fail(std::current_exception());
+		}
+
+		for (auto& w : workers)
+		{
+			w.wait();
+		}
+
+		if (metrics != nullptr)
+		{
+			metrics->finish();
+		}
+
+		state.rethrowError();
+	}
+}
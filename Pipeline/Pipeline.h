@@ -0,0 +1,200 @@
+#ifndef __PIPELINE_H_INCLUDED__
+#define __PIPELINE_H_INCLUDED__
+
+#include "Concurrent queue\ConcurrentQueue.h"
+#include "PipelineMetrics.h"
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <algorithm>
+
+namespace IDragnev::Multithreading
+{
+	namespace Detail
+	{
+		//what the stages of a running pipeline share
+		class PipelineState
+		{
+		private:
+			using LockGuard = std::lock_guard<std::mutex>;
+
+		public:
+			explicit PipelineState(PipelineMetrics* metrics = nullptr) noexcept : metrics{ metrics } { }
+			PipelineState(const PipelineState&) = delete;
+			~PipelineState() = default;
+
+			PipelineState& operator=(const PipelineState&) = delete;
+
+			void addChannel(std::function<void()> close);
+
+			//keeps the first error and cancels the pipeline
+			void fail(std::exception_ptr error);
+			//closes every channel, which wakes and stops all stages
+			void cancel();
+			bool isCancelled() const noexcept { return cancelled.load(); }
+			void rethrowError() const;
+
+			PipelineMetrics* getMetrics() const noexcept { return metrics; }
+
+		private:
+			PipelineMetrics* metrics;
+			std::atomic<bool> cancelled = false;
+			std::mutex mutex;
+			std::exception_ptr error;
+			std::vector<std::function<void()>> channelClosers;
+		};
+
+		using StatePtr = std::shared_ptr<PipelineState>;
+
+		//a bounded queue between two stages which counts its items and,
+		//when the pipeline is measured, stamps them with their push time
+		template <typename T>
+		class Channel
+		{
+		public:
+			struct Entry
+			{
+				T item;
+				MetricsClock::time_point pushed;
+			};
+
+			explicit Channel(std::size_t capacity) : queue(capacity) { }
+
+			//the depth is raised first, so that it never drops below zero
+			bool push(T item, bool stamp)
+			{
+				auto pushed = stamp ? MetricsClock::now() : MetricsClock::time_point{};
+				depth.fetch_add(1, std::memory_order_relaxed);
+
+				if (!queue.push({ std::move(item), pushed }))
+				{
+					depth.fetch_sub(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				return true;
+			}
+
+			std::optional<Entry> waitAndPop()
+			{
+				auto result = queue.waitAndPop();
+				if (result)
+				{
+					depth.fetch_sub(1, std::memory_order_relaxed);
+				}
+
+				return result;
+			}
+
+			void close() { queue.close(); }
+			std::size_t getDepth() const noexcept { return static_cast<std::size_t>(std::max<std::ptrdiff_t>(depth.load(std::memory_order_relaxed), 0)); }
+
+		private:
+			ConcurrentQueue<Entry, TwoLock> queue;
+			std::atomic<std::ptrdiff_t> depth = 0;
+		};
+
+		//the work of a stage, run by parallelism threads
+		struct Stage
+		{
+			std::size_t parallelism;
+			std::function<void()> work;
+		};
+
+		using Stages = std::vector<Stage>;
+
+		//finish is called by the last worker of the stage to exit,
+		//metrics is the one of the stage if the pipeline is measured
+		Stage makeStage(StatePtr state, std::size_t parallelism, std::function<void()> work, std::function<void()> finish, StageMetrics* metrics);
+		//blocks until all stages are done and rethrows the first error
+		void runStages(PipelineState& state, const Stages& stages);
+
+		template <typename T>
+		struct OptionalTraits
+		{
+			using ValueType = T;
+			static constexpr bool isOptional = false;
+		};
+
+		template <typename T>
+		struct OptionalTraits<std::optional<T>>
+		{
+			using ValueType = T;
+			static constexpr bool isOptional = true;
+		};
+	}
+
+	//A chain of typed stages connected by bounded channels:
+	//
+	//    Pipeline<std::string>::from([](const auto& emit) { emit("a"); emit("b"); })
+	//        .then([](std::string s) { return s.size(); }, 4)
+	//        .run([](std::size_t n) { std::cout << n; });
+	//
+	//The source pushes items through emit, which returns false once the
+	//pipeline is cancelled. Every other stage is a function of one item,
+	//run by as many threads as its parallelism. A stage returning
+	//std::optional drops the items it maps to std::nullopt.
+	//Each stage closes its output when its last worker is done, so the
+	//end of the stream flows downstream. The first exception thrown by
+	//any stage cancels the others and is rethrown by run.
+	//A run given a PipelineMetrics records it for every stage in order,
+	//starting with the source.
+	template <typename T>
+	class Pipeline
+	{
+	private:
+		template <typename U>
+		friend class Pipeline;
+
+		using Channel = Detail::Channel<T>;
+		using ChannelPtr = std::shared_ptr<Channel>;
+
+	public:
+		using Emit = std::function<bool(T)>;
+
+		static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+		//source is called with an Emit and runs on its own thread,
+		//capacity bounds the channel after it
+		template <typename Source>
+		static Pipeline from(Source source, std::size_t capacity = DEFAULT_CAPACITY, PipelineMetrics* metrics = nullptr);
+
+		Pipeline(Pipeline&& source) = default;
+		Pipeline(const Pipeline&) = delete;
+		~Pipeline() = default;
+
+		Pipeline& operator=(Pipeline&& rhs) = default;
+		Pipeline& operator=(const Pipeline&) = delete;
+
+		template <typename Transform>
+		auto then(Transform f, std::size_t parallelism = 1, std::size_t capacity = DEFAULT_CAPACITY) &&;
+
+		//starts all stages and blocks until they are done
+		template <typename Sink>
+		void run(Sink sink, std::size_t parallelism = 1) &&;
+
+	private:
+		Pipeline(Detail::StatePtr state, Detail::Stages stages, ChannelPtr output);
+
+		static ChannelPtr makeChannel(Detail::PipelineState& state, std::size_t capacity);
+
+		//nullptr if the pipeline is not measured
+		StageMetrics* measureStage(std::size_t parallelism) const;
+
+		template <typename Consume>
+		std::function<void()> consumeOutputWith(Consume consume, StageMetrics* metrics) const;
+
+	private:
+		Detail::StatePtr state;
+		Detail::Stages stages;
+		ChannelPtr output;
+	};
+}
+
+#include "PipelineImpl.hpp"
+#endif //__PIPELINE_H_INCLUDED__
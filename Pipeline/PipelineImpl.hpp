@@ -0,0 +1,189 @@
+#include <assert.h>
+
+namespace IDragnev::Multithreading
+{
+	template <typename T>
+	Pipeline<T>::Pipeline(Detail::StatePtr state, Detail::Stages stages, ChannelPtr output) :
+		state(std::move(state)),
+		stages(std::move(stages)),
+		output(std::move(output))
+	{
+	}
+
+	template <typename T>
+	auto Pipeline<T>::makeChannel(Detail::PipelineState& state, std::size_t capacity) -> ChannelPtr
+	{
+		auto channel = std::make_shared<Channel>(capacity);
+		state.addChannel([channel] { channel->close(); });
+
+		return channel;
+	}
+
+	//the metrics only observe the depth of the channel,
+	//they do not keep it alive after the run
+	template <typename T>
+	StageMetrics* Pipeline<T>::measureStage(std::size_t parallelism) const
+	{
+		if (auto metrics = state->getMetrics(); metrics != nullptr)
+		{
+			auto input = std::weak_ptr<Channel>{ output };
+			return &metrics->addStage(parallelism, [input] 
+			{ 
+				auto channel = input.lock();
+				return channel ? channel->getDepth() : 0;
+			});
+		}
+
+		return nullptr;
+	}
+
+	//the source is busy for as long as it runs,
+	//except when it is blocked on a full channel
+	template <typename T>
+	template <typename Source>
+	Pipeline<T> Pipeline<T>::from(Source source, std::size_t capacity, PipelineMetrics* metrics)
+	{
+		if (metrics != nullptr)
+		{
+			metrics->clear();
+		}
+
+		auto state = std::make_shared<Detail::PipelineState>(metrics);
+		auto output = makeChannel(*state, capacity);
+		auto stage = (metrics != nullptr) ? &metrics->addStage(1, nullptr) : nullptr;
+
+		auto work = [output, source, stage]() mutable
+		{
+			auto started = MetricsClock::now();
+			auto blocked = MetricsClock::duration{ 0 };
+
+			auto emit = Emit{ [&output, &blocked, stage](T item) 
+			{
+				if (stage == nullptr)
+				{
+					return output->push(std::move(item), false);
+				}
+
+				auto pushing = MetricsClock::now();
+				auto pushed = output->push(std::move(item), true);
+				blocked += MetricsClock::now() - pushing;
+
+				if (pushed)
+				{
+					stage->recordOutput();
+				}
+
+				return pushed;
+			} };
+
+			source(emit);
+
+			if (stage != nullptr)
+			{
+				stage->addBusyTime(MetricsClock::now() - started - blocked);
+			}
+		};
+
+		auto stages = Detail::Stages{};
+		stages.push_back(Detail::makeStage(state, 1, std::move(work), [output] { output->close(); }, stage));
+
+		return { std::move(state), std::move(stages), std::move(output) };
+	}
+
+	//consume returns false to stop the worker before the end of the stream
+	template <typename T>
+	template <typename Consume>
+	std::function<void()> Pipeline<T>::consumeOutputWith(Consume consume, StageMetrics* metrics) const
+	{
+		return [state = state, input = output, consume, metrics]() mutable
+		{
+			while (!state->isCancelled())
+			{
+				auto entry = input->waitAndPop();
+				if (entry == std::nullopt)
+				{
+					break;
+				}
+
+				if (metrics != nullptr)
+				{
+					metrics->recordTake(input->getDepth(), MetricsClock::now() - entry->pushed);
+				}
+
+				if (!consume(std::move(entry->item)))
+				{
+					break;
+				}
+			}
+		};
+	}
+
+	//only the call of f is timed, not the push to a full channel
+	template <typename T>
+	template <typename Transform>
+	auto Pipeline<T>::then(Transform f, std::size_t parallelism, std::size_t capacity) &&
+	{
+		using Result = std::invoke_result_t<Transform&, T>;
+		using Traits = Detail::OptionalTraits<Result>;
+		using Next = Pipeline<typename Traits::ValueType>;
+
+		assert(parallelism > 0);
+
+		auto metrics = measureStage(parallelism);
+		auto next = Next::makeChannel(*state, capacity);
+
+		auto work = consumeOutputWith([next, f, metrics](T item) mutable
+		{
+			auto started = (metrics != nullptr) ? MetricsClock::now() : MetricsClock::time_point{};
+			auto result = f(std::move(item));
+
+			if constexpr (Traits::isOptional)
+			{
+				if (metrics != nullptr)
+				{
+					metrics->recordProcessing(MetricsClock::now() - started, result != std::nullopt);
+				}
+
+				return result == std::nullopt || next->push(std::move(*result), metrics != nullptr);
+			}
+			else
+			{
+				if (metrics != nullptr)
+				{
+					metrics->recordProcessing(MetricsClock::now() - started, true);
+				}
+
+				return next->push(std::move(result), metrics != nullptr);
+			}
+		}, metrics);
+
+		stages.push_back(Detail::makeStage(state, parallelism, std::move(work), [next] { next->close(); }, metrics));
+
+		return Next{ std::move(state), std::move(stages), std::move(next) };
+	}
+
+	template <typename T>
+	template <typename Sink>
+	void Pipeline<T>::run(Sink sink, std::size_t parallelism) &&
+	{
+		assert(parallelism > 0);
+
+		auto metrics = measureStage(parallelism);
+
+		auto work = consumeOutputWith([sink, metrics](T item) mutable
+		{
+			auto started = (metrics != nullptr) ? MetricsClock::now() : MetricsClock::time_point{};
+			sink(std::move(item));
+
+			if (metrics != nullptr)
+			{
+				metrics->recordProcessing(MetricsClock::now() - started, true);
+			}
+
+			return true;
+		}, metrics);
+
+		stages.push_back(Detail::makeStage(state, parallelism, std::move(work), [] {}, metrics));
+		Detail::runStages(*state, stages);
+	}
+}
@@ -0,0 +1,261 @@
+#include "PipelineMetrics.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace IDragnev::Multithreading
+{
+	namespace
+	{
+		thread_local StageMetrics* currentStage = nullptr;
+
+		std::size_t bucketOf(std::uint64_t nanoseconds) noexcept
+		{
+			auto bucket = std::size_t{ 0 };
+			for (; nanoseconds != 0; nanoseconds >>= 1)
+			{
+				++bucket;
+			}
+
+			return std::min(bucket, LatencyHistogram::BUCKETS - 1);
+		}
+
+		std::uint64_t toNanoseconds(std::chrono::nanoseconds duration) noexcept
+		{
+			return static_cast<std::uint64_t>(std::max(duration.count(), std::chrono::nanoseconds::rep{ 0 }));
+		}
+	}
+
+	void LatencyHistogram::record(std::chrono::nanoseconds duration) noexcept
+	{
+		auto nanoseconds = toNanoseconds(duration);
+
+		buckets[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+		totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+		count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	auto LatencyHistogram::snapshot() const noexcept -> Snapshot
+	{
+		auto result = Snapshot{};
+		result.count = count.load(std::memory_order_relaxed);
+		result.totalNanoseconds = totalNanoseconds.load(std::memory_order_relaxed);
+
+		for (auto i = std::size_t{ 0 }; i < BUCKETS; ++i)
+		{
+			result.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+		}
+
+		return result;
+	}
+
+	std::chrono::nanoseconds LatencyHistogram::Snapshot::mean() const noexcept
+	{
+		return std::chrono::nanoseconds{ count > 0 ? totalNanoseconds / count : 0 };
+	}
+
+	//the buckets are read one by one while they are being updated,
+	//so their sum may differ slightly from count
+	std::chrono::nanoseconds LatencyHistogram::Snapshot::percentile(double p) const noexcept
+	{
+		auto total = std::uint64_t{ 0 };
+		for (auto c : buckets)
+		{
+			total += c;
+		}
+
+		auto rank = static_cast<std::uint64_t>(p * total);
+		auto seen = std::uint64_t{ 0 };
+
+		for (auto i = std::size_t{ 0 }; i < BUCKETS; ++i)
+		{
+			seen += buckets[i];
+			if (seen > rank || (seen == total && seen > 0))
+			{
+				return std::chrono::nanoseconds{ (i > 0) ? (std::uint64_t{ 1 } << (i - 1)) * 2 - 1 : 0 };
+			}
+		}
+
+		return std::chrono::nanoseconds{ 0 };
+	}
+
+	StageMetrics::StageMetrics(std::string name, std::size_t parallelism, std::function<std::size_t()> inputDepth) :
+		name{ std::move(name) },
+		parallelism{ parallelism },
+		inputDepth{ std::move(inputDepth) }
+	{
+	}
+
+	void StageMetrics::recordTake(std::size_t depth, std::chrono::nanoseconds waited) noexcept
+	{
+		itemsIn.fetch_add(1, std::memory_order_relaxed);
+		depthSum.fetch_add(depth, std::memory_order_relaxed);
+		waiting.record(waited);
+
+		for (auto max = maxDepth.load(std::memory_order_relaxed);
+			 depth > max && !maxDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed);
+			 )
+		{
+		}
+	}
+
+	void StageMetrics::recordProcessing(std::chrono::nanoseconds duration, bool produced) noexcept
+	{
+		processing.record(duration);
+		addBusyTime(duration);
+
+		if (produced)
+		{
+			recordOutput();
+		}
+	}
+
+	void StageMetrics::recordOutput() noexcept
+	{
+		itemsOut.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void StageMetrics::addBusyTime(std::chrono::nanoseconds duration) noexcept
+	{
+		busyNanoseconds.fetch_add(toNanoseconds(duration), std::memory_order_relaxed);
+	}
+
+	void StageMetrics::addBytes(std::uint64_t count) noexcept
+	{
+		bytes.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	auto StageMetrics::snapshot(std::chrono::nanoseconds elapsed) const -> Snapshot
+	{
+		auto result = Snapshot{};
+		result.name = name;
+		result.parallelism = parallelism;
+		result.itemsIn = itemsIn.load(std::memory_order_relaxed);
+		result.itemsOut = itemsOut.load(std::memory_order_relaxed);
+		result.bytes = bytes.load(std::memory_order_relaxed);
+		result.busy = std::chrono::nanoseconds{ busyNanoseconds.load(std::memory_order_relaxed) };
+		result.queueDepth = inputDepth ? inputDepth() : 0;
+		result.maxQueueDepth = maxDepth.load(std::memory_order_relaxed);
+		result.meanQueueDepth = (result.itemsIn > 0) ? static_cast<double>(depthSum.load(std::memory_order_relaxed)) / result.itemsIn : 0;
+		result.processing = processing.snapshot();
+		result.waiting = waiting.snapshot();
+
+		if (auto available = elapsed.count() * static_cast<double>(parallelism); available > 0)
+		{
+			result.utilization = std::min(1.0, result.busy.count() / available);
+		}
+
+		return result;
+	}
+
+	PipelineMetrics::PipelineMetrics(std::vector<std::string> stageNames) :
+		stageNames{ std::move(stageNames) }
+	{
+	}
+
+	void PipelineMetrics::setStageNames(std::vector<std::string> names)
+	{
+		auto lock = LockGuard(mutex);
+		stageNames = std::move(names);
+	}
+
+	void PipelineMetrics::clear()
+	{
+		auto lock = LockGuard(mutex);
+		stages.clear();
+		started.store(0);
+		finished.store(0);
+	}
+
+	StageMetrics& PipelineMetrics::addStage(std::size_t parallelism, std::function<std::size_t()> inputDepth)
+	{
+		auto lock = LockGuard(mutex);
+		auto index = stages.size();
+		auto name = (index < stageNames.size()) ? stageNames[index] : "stage " + std::to_string(index);
+
+		stages.push_back(std::make_unique<StageMetrics>(std::move(name), parallelism, std::move(inputDepth)));
+
+		return *stages.back();
+	}
+
+	void PipelineMetrics::start() noexcept
+	{
+		started.store(MetricsClock::now().time_since_epoch().count());
+	}
+
+	void PipelineMetrics::finish() noexcept
+	{
+		finished.store(MetricsClock::now().time_since_epoch().count());
+	}
+
+	std::chrono::nanoseconds PipelineMetrics::getElapsed() const noexcept
+	{
+		auto start = started.load();
+		if (start == 0)
+		{
+			return std::chrono::nanoseconds{ 0 };
+		}
+
+		auto end = finished.load();
+		auto endTime = (end != 0) ? MetricsClock::time_point{ MetricsClock::duration{ end } } : MetricsClock::now();
+
+		return endTime - MetricsClock::time_point{ MetricsClock::duration{ start } };
+	}
+
+	auto PipelineMetrics::snapshot() const -> Snapshot
+	{
+		auto lock = LockGuard(mutex);
+		auto result = Snapshot{ getElapsed(), {} };
+
+		for (const auto& stage : stages)
+		{
+			result.stages.push_back(stage->snapshot(result.elapsed));
+		}
+
+		return result;
+	}
+
+	void PipelineMetrics::addBytes(std::uint64_t count) noexcept
+	{
+		if (currentStage != nullptr)
+		{
+			currentStage->addBytes(count);
+		}
+	}
+
+	void PipelineMetrics::setCurrentStage(StageMetrics* stage) noexcept
+	{
+		currentStage = stage;
+	}
+
+	std::ostream& operator<<(std::ostream& out, const PipelineMetrics::Snapshot& snapshot)
+	{
+		using std::setw;
+		using std::chrono::duration_cast;
+		using Microseconds = std::chrono::microseconds;
+
+		auto us = [](std::chrono::nanoseconds d) { return duration_cast<Microseconds>(d).count(); };
+		auto flags = out.flags();
+		auto precision = out.precision();
+
+		out << "elapsed " << us(snapshot.elapsed) << " us\n"
+			<< std::left << setw(12) << "stage" << std::right
+			<< setw(4) << "par" << setw(10) << "in" << setw(10) << "out" << setw(12) << "bytes"
+			<< setw(7) << "util" << setw(8) << "depth" << setw(6) << "max"
+			<< " | proc p50     p99 | wait p50     p99  (us)\n";
+
+		for (const auto& s : snapshot.stages)
+		{
+			out << std::left << setw(12) << s.name << std::right
+				<< setw(4) << s.parallelism << setw(10) << s.itemsIn << setw(10) << s.itemsOut << setw(12) << s.bytes
+				<< setw(6) << std::fixed << std::setprecision(0) << s.utilization * 100 << "%"
+				<< setw(8) << std::setprecision(1) << s.meanQueueDepth << setw(6) << s.maxQueueDepth
+				<< " | " << setw(8) << us(s.processing.percentile(0.5)) << setw(8) << us(s.processing.percentile(0.99))
+				<< " | " << setw(8) << us(s.waiting.percentile(0.5)) << setw(8) << us(s.waiting.percentile(0.99)) << "\n";
+		}
+
+		out.flags(flags);
+		out.precision(precision);
+
+		return out;
+	}
+}
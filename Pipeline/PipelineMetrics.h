@@ -0,0 +1,151 @@
+#ifndef __PIPELINE_METRICS_H_INCLUDED__
+#define __PIPELINE_METRICS_H_INCLUDED__
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace IDragnev::Multithreading
+{
+	using MetricsClock = std::chrono::steady_clock;
+
+	//A histogram of durations with power-of-two buckets:
+	//bucket i counts the durations in [2^(i - 1), 2^i) nanoseconds.
+	//Recording is a few relaxed atomic increments.
+	class LatencyHistogram
+	{
+	public:
+		static constexpr std::size_t BUCKETS = 64;
+
+		struct Snapshot
+		{
+			std::uint64_t count = 0;
+			std::uint64_t totalNanoseconds = 0;
+			std::array<std::uint64_t, BUCKETS> buckets = {};
+
+			std::chrono::nanoseconds mean() const noexcept;
+			//the upper bound of the bucket holding the p-th quantile, 0 <= p <= 1
+			std::chrono::nanoseconds percentile(double p) const noexcept;
+		};
+
+		void record(std::chrono::nanoseconds duration) noexcept;
+		Snapshot snapshot() const noexcept;
+
+	private:
+		std::atomic<std::uint64_t> count = 0;
+		std::atomic<std::uint64_t> totalNanoseconds = 0;
+		std::array<std::atomic<std::uint64_t>, BUCKETS> buckets = {};
+	};
+
+	//what the workers of a single pipeline stage record
+	class StageMetrics
+	{
+	public:
+		struct Snapshot
+		{
+			std::string name;
+			std::size_t parallelism = 0;
+			std::uint64_t itemsIn = 0;
+			std::uint64_t itemsOut = 0;
+			std::uint64_t bytes = 0;
+			std::chrono::nanoseconds busy{ 0 };
+			//the share of the run its workers were busy, in [0, 1]
+			double utilization = 0;
+			//of the queue feeding the stage, sampled on every take
+			std::size_t queueDepth = 0;
+			std::size_t maxQueueDepth = 0;
+			double meanQueueDepth = 0;
+			//the time an item spent in the stage and waiting in its queue
+			LatencyHistogram::Snapshot processing;
+			LatencyHistogram::Snapshot waiting;
+		};
+
+		StageMetrics(std::string name, std::size_t parallelism, std::function<std::size_t()> inputDepth);
+		StageMetrics(const StageMetrics&) = delete;
+		~StageMetrics() = default;
+
+		StageMetrics& operator=(const StageMetrics&) = delete;
+
+		//depth is that of the queue right after the item was taken
+		void recordTake(std::size_t depth, std::chrono::nanoseconds waited) noexcept;
+		void recordProcessing(std::chrono::nanoseconds duration, bool produced) noexcept;
+		void recordOutput() noexcept;
+		void addBusyTime(std::chrono::nanoseconds duration) noexcept;
+		void addBytes(std::uint64_t count) noexcept;
+
+		Snapshot snapshot(std::chrono::nanoseconds elapsed) const;
+
+	private:
+		std::string name;
+		std::size_t parallelism;
+		std::function<std::size_t()> inputDepth;
+		std::atomic<std::uint64_t> itemsIn = 0;
+		std::atomic<std::uint64_t> itemsOut = 0;
+		std::atomic<std::uint64_t> bytes = 0;
+		std::atomic<std::uint64_t> busyNanoseconds = 0;
+		std::atomic<std::uint64_t> depthSum = 0;
+		std::atomic<std::size_t> maxDepth = 0;
+		LatencyHistogram processing;
+		LatencyHistogram waiting;
+	};
+
+	//The metrics of a Pipeline run, one StageMetrics per stage in the
+	//order the stages were added. A PipelineMetrics is filled by one run
+	//at a time and starts over with every new run; snapshots may be taken
+	//from any thread, also while the pipeline is running.
+	class PipelineMetrics
+	{
+	private:
+		using LockGuard = std::lock_guard<std::mutex>;
+
+	public:
+		struct Snapshot
+		{
+			std::chrono::nanoseconds elapsed{ 0 };
+			std::vector<StageMetrics::Snapshot> stages;
+		};
+
+		//the stages are named in order, the unnamed ones by their index
+		explicit PipelineMetrics(std::vector<std::string> stageNames = {});
+		PipelineMetrics(const PipelineMetrics&) = delete;
+		~PipelineMetrics() = default;
+
+		PipelineMetrics& operator=(const PipelineMetrics&) = delete;
+
+		Snapshot snapshot() const;
+		void setStageNames(std::vector<std::string> names);
+
+		//counts bytes for the stage run by the calling thread,
+		//does nothing on threads outside a measured stage
+		static void addBytes(std::uint64_t count) noexcept;
+
+		//used by Pipeline
+		void clear();
+		StageMetrics& addStage(std::size_t parallelism, std::function<std::size_t()> inputDepth);
+		void start() noexcept;
+		void finish() noexcept;
+		static void setCurrentStage(StageMetrics* stage) noexcept;
+
+	private:
+		std::chrono::nanoseconds getElapsed() const noexcept;
+
+	private:
+		mutable std::mutex mutex;
+		std::vector<std::string> stageNames;
+		std::vector<std::unique_ptr<StageMetrics>> stages;
+		std::atomic<MetricsClock::rep> started = 0;
+		std::atomic<MetricsClock::rep> finished = 0;
+	};
+
+	//a table of the stages with their counts, utilization and latency percentiles
+	std::ostream& operator<<(std::ostream& out, const PipelineMetrics::Snapshot& snapshot);
+}
+
+#endif //__PIPELINE_METRICS_H_INCLUDED__
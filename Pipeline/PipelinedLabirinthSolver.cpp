@@ -1,184 +1,247 @@
 #include "PipelinedLabirinthSolver.h"
 #include "DirectoryTextFilesFlatIterator.h"
-#include "UtilityFunctions.h"
-#include "Ranges\Ranges.h"
-#include "Functional\Functional.h"
-#include <future>
-#include "range/v3/all.hpp" 
-
-using IDragnev::Utility::CallOnDestruction;
+#include "ParallelDirectoryScanner.h"
+#include "XXHash64.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <cctype>
+#include <string>
+#include <iostream>
+#include <assert.h>
 
 namespace IDragnev::Multithreading
 {
-	class FailedToOpen : public std::runtime_error
-	{
-	public:
-		FailedToOpen(const std::string& filename) :
-			std::runtime_error{ "Failed to open " + filename }
-		{
-		}
-	};
-
-	const auto openFile = [](const auto& filename) -> std::ifstream
+	//splits the contents on whitespace, as reading
+	//them word by word from a stream would
+	const auto splitIntoRows = [](std::string_view contents)
 	{
-		auto file = std::ifstream{ filename };
+		auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+		auto rows = std::vector<std::string_view>{};
+		auto end = std::cend(contents);
 
-		if (!file.is_open())
+		for (auto current = std::find_if_not(std::cbegin(contents), end, isSpace);
+			 current != end;
+			 current = std::find_if_not(current, end, isSpace))
 		{
-			throw FailedToOpen{ filename };
+			auto rowEnd = std::find_if(current, end, isSpace);
+			rows.emplace_back(&*current, static_cast<std::size_t>(rowEnd - current));
+			current = rowEnd;
 		}
 
-		return file;
+		return rows;
 	};
 
-	const auto parseFile = [](std::ifstream file) -> std::vector<std::string>
+	PipelinedLabirinthSolver::PipelinedLabirinthSolver(const Options& options) :
+		options(options)
 	{
-		return ranges::istream_range<std::string>{ file };
-	};
-
-	auto loadFile = Functional::compose(parseFile, openFile);
+		assert(options.loaders > 0 && options.solvers > 0 && options.scanners > 0 && options.searchThreads > 0);
+	}
 
-	PipelinedLabirinthSolver::PipelinedLabirinthSolver(const Self&)
+	auto PipelinedLabirinthSolver::operator()(const std::string& path) const -> Result
 	{
+		auto solutions = Solutions{};
+		solveAll([this, &path](const Emit& emit) { scanForTextFiles(path, emit); },
+			     [&solutions](Solution s) { solutions.push_back(std::move(s)); });
+
+		return toResult(std::move(solutions));
 	}
 
-	PipelinedLabirinthSolver& PipelinedLabirinthSolver::operator=(const Self&)
+	void PipelinedLabirinthSolver::operator()(const std::string& path, const OnSolution& onSolution) const
 	{
-		return *this;
+		solveAll([this, &path](const Emit& emit) { scanForTextFiles(path, emit); }, onSolution);
 	}
 
-	auto PipelinedLabirinthSolver::operator()(const std::string& path) -> Result
+	void PipelinedLabirinthSolver::watch(DirectoryWatcher& watcher, const OnSolution& onSolution) const
 	{
-		using Barrier = std::future<void>;
+		auto findFiles = [&watcher](const Emit& emit)
+		{
+			watcher([&emit](auto filename) { return emit(std::move(filename)); });
+		};
 
-		auto x = CallOnDestruction{ [this]() noexcept { clear(); } };
-		Barrier solver;
-		Barrier loader;
+		solveAll(findFiles, onSolution);
+	}
 
-		try
-		{
-			solver = std::async(std::launch::async, [this] { solveLabirinths(); });
-			loader = std::async(std::launch::async, [this] { loadFiles(); });
-			scanForTextFiles(path);
+	//the solutions are delivered by a single collecting stage,
+	//so onSolution needs no synchronization;
+	//the cached solutions pass through the solvers untouched
+	void PipelinedLabirinthSolver::solveAll(const std::function<void(const Emit&)>& findFiles, const OnSolution& onSolution) const
+	{
+		auto cache = options.cacheFile.empty() ? nullptr : std::make_unique<ResultCache>(options.cacheFile);
 
-			loader.wait();
-			solver.wait();
-		}
-		catch (...)
+		if (options.metrics != nullptr)
 		{
-			abort.store(true);
-			throw;
+			options.metrics->setStageNames({ "files", "load", "solve", "collect" });
 		}
 
-		return std::move(result);
+		Pipeline<File>::from(findFiles, MAX_PENDING_FILES, options.metrics)
+			.then([c = cache.get(), s = cacheSeed()](File f) { return load(std::move(f), c, s); }, options.loaders, MAX_LOADED_LABIRINTHS)
+			.then([this, c = cache.get()](Labirinth l) { return solve(std::move(l), c); }, options.solvers)
+			.run(onSolution);
 	}
 
-	void PipelinedLabirinthSolver::clear() noexcept
+	auto PipelinedLabirinthSolver::toResult(Solutions solutions) const -> Result
 	{
-		result.clear();
-		labirinths.tryToClear();
-		files.tryToClear();
-		abort.store(false);
+		//the order of the scan depends on the timing of the scanning threads
+		auto bySource = [](const auto& lhs, const auto& rhs) { return lhs.source < rhs.source; };
+
+		if (options.ordering == Ordering::bySource)
+		{
+			std::sort(std::begin(solutions), std::end(solutions), bySource);
+		}
+
+		auto result = Result{};
+		result.reserve(solutions.size());
+
+		for (auto& solution : solutions)
+		{
+			result.push_back(std::move(solution.paths));
+		}
+
+		return result;
 	}
 
-	void PipelinedLabirinthSolver::loadFiles()
+	auto PipelinedLabirinthSolver::load(File file, const ResultCache* cache, ResultCache::Key seed) -> std::optional<Labirinth>
 	{
-		while (!abort.load())
+		try
 		{
-			if (auto file = files.tryToExtractFront(); 
-				file != nullptr)
+			//the file is unmapped as soon as its rows are in the grid
+			auto mapped = MappedFile{ file };
+			auto labirinth = Labirinth{};
+			PipelineMetrics::addBytes(mapped.getContents().size());
+
+			if (cache != nullptr)
 			{
-				if(!isSentinel(file))
-				{		
-					load(std::move(file));
-				}
-				else
-				{
-					break;
-				}
+				labirinth.hash = xxHash64(mapped.getContents(), seed);
+				labirinth.cached = cache->find(labirinth.hash);
 			}
-			else
+
+			if (!labirinth.cached)
 			{
-				std::this_thread::yield();
+				auto rows = splitIntoRows(mapped.getContents());
+				labirinth.grid = Grid::fromRows(std::cbegin(rows), std::cend(rows));
 			}
-		}
 
-		insertSentinelLabirinth();
+			labirinth.source = std::move(file);
+			return labirinth;
+		}
+		catch (...)
+		{
+			std::cerr << "Failed to load " << file << "\n";
+			return std::nullopt;
+		}
 	}
 
-	void PipelinedLabirinthSolver::load(std::unique_ptr<std::optional<std::string>> file)
+	auto PipelinedLabirinthSolver::solve(Labirinth labirinth, ResultCache* cache) const -> std::optional<Solution>
 	{
-		const auto& filename = file->value();
+		auto& [source, grid, hash, cached] = labirinth;
+
+		if (cached)
+		{
+			return Solution{ std::move(source), std::move(*cached) };
+		}
+
 		try
 		{
-			labirinths.insertBack(loadFile(filename));
+			auto solution = Solution{ std::move(source), solve(grid) };
+
+			if (cache != nullptr && !mayBeTruncated(solution.paths))
+			{
+				store(*cache, hash, solution);
+			}
+
+			return solution;
 		}
-		catch (...)
+		catch (std::bad_alloc&)
+		{ 
+			std::cerr << "Error while sloving a labirinth. No memory available\n";
+			return std::nullopt;
+		}
+	}
+
+	//the results depend on the engine and on the options it is given,
+	//so each combination has its own keys in the cache; the search threads
+	//change only which paths a truncated result has, which is never cached.
+	//LabirinthSolver keeps the seed 0, so its existing records stay valid
+	ResultCache::Key PipelinedLabirinthSolver::cacheSeed() const
+	{
+		if (options.engine == Engine::labirinthSolver)
+		{
+			return 0;
+		}
+
+		auto parameters = std::string{ options.alphabet.wall, options.alphabet.start, options.alphabet.end };
+
+		if (options.engine == Engine::allPaths)
 		{
-			std::cerr << "Failed to load " << filename << "\n";
+			parameters += std::to_string(options.maxPaths);
 		}
+
+		return xxHash64(parameters, static_cast<std::uint64_t>(options.engine));
 	}
 
-	void PipelinedLabirinthSolver::insertSentinelLabirinth()
+	//the all-paths engine stops at maxPaths and which paths it keeps
+	//then depends on the timing of its threads
+	bool PipelinedLabirinthSolver::mayBeTruncated(const LabirinthSolver::Result& paths) const noexcept
 	{
-		labirinths.insertBack(std::nullopt);
+		return options.engine == Engine::allPaths && paths.size() >= options.maxPaths;
 	}
 
-	void PipelinedLabirinthSolver::solveLabirinths()
+	LabirinthSolver::Result PipelinedLabirinthSolver::solve(const Grid& grid) const
 	{
-		while(!abort.load())
+		if (options.engine == Engine::bitParallel)
 		{
-			if (auto lab = labirinths.tryToExtractFront(); 
-				lab != nullptr)
-			{
-				if (!isSentinel(lab))
-				{
-					solve(std::move(lab));
-				}
-				else
-				{
-					break;
-				}
-			}
-			else
-			{
-				std::this_thread::yield();
-			}
+			auto solver = BitParallelSolver{ options.alphabet, options.searchThreads, options.minParallelCells };
+			return solver(grid);
 		}
+
+		if (options.engine == Engine::allPaths)
+		{
+			auto solver = AllPathsSolver{ options.alphabet, options.searchThreads, options.maxPaths, options.minParallelPathCells };
+			return solver(grid);
+		}
+
+		auto rows = grid.rows();
+		return LabirinthSolver{}(std::cbegin(rows), std::cend(rows));
 	}
 
-	void PipelinedLabirinthSolver::solve(std::unique_ptr<std::optional<Labirinth>> lab)
+	//a solution that cannot be cached is still delivered
+	void PipelinedLabirinthSolver::store(ResultCache& cache, ResultCache::Key hash, const Solution& solution)
 	{
-		auto solver = LabirinthSolver{};
-
 		try
 		{
-			const auto& labirinth = lab->value();
-			result.push_back(solver(std::cbegin(labirinth), std::cend(labirinth)));
+			cache.insert(hash, solution.paths);
 		}
-		catch (std::bad_alloc&)
-		{ 
-			std::cerr << "Error while sloving a labirinth. No memory available\n";
+		catch (std::exception& e)
+		{
+			std::cerr << "Failed to cache the solution of " << solution.source << ": " << e.what() << "\n";
 		}
 	}
 
-	void PipelinedLabirinthSolver::scanForTextFiles(const std::string& path)
+	void PipelinedLabirinthSolver::scanForTextFiles(const std::string& path, const Emit& emit) const
 	{
-		using IDragnev::Ranges::forEach;
 		using Iterator = DirectoryTextFilesFlatIterator;
 
-		auto it = Iterator{ path };
-
-		forEach(it, [this](auto filename) 
-		{ 
-			files.insertBack(std::move(filename));
-		});
-
-		insertSentinelFile();
-	}
+		if (options.recursive)
+		{
+			auto scan = ParallelDirectoryScanner{ options.scanners };
 
-	void PipelinedLabirinthSolver::insertSentinelFile()
-	{
-		files.insertBack(std::nullopt);
+			//the scan stops once the pipeline is cancelled
+			scan(path, [&emit](auto filename)
+			{
+				return emit(std::move(filename));
+			});
+		}
+		else
+		{
+			//stops once the pipeline is cancelled, as the scan above
+			for (auto it = Iterator{ path }; it; ++it)
+			{
+				if (!emit(*it))
+				{
+					break;
+				}
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -1,11 +1,18 @@
 #ifndef __PIPELENED_LAB_SOLVER_H_INCLUDED__
 #define __PIPELENED_LAB_SOLVER_H_INCLUDED__
 
-#include "ThreadSafeQueue.h"
+#include "Pipeline.h"
 #include "LabirinthSolver.h"
-#include <fstream>
+#include "BitParallelSolver.h"
+#include "AllPathsSolver.h"
+#include "MappedFile.h"
+#include "Grid.h"
+#include "ResultCache.h"
+#include "DirectoryWatcher.h"
 #include <optional>
-#include <atomic>
+#include <functional>
+#include <thread>
+#include <algorithm>
 
 namespace IDragnev::Multithreading
 {
@@ -13,39 +20,123 @@ namespace IDragnev::Multithreading
 	{
 	private:
 		using Self = PipelinedLabirinthSolver;
-		using Labirinth = std::vector<std::string>;
+		//a labirinth found in the cache has its
+		//solution instead of a grid to solve
+		struct Labirinth
+		{
+			std::string source;
+			Grid grid;
+			ResultCache::Key hash = 0;
+			std::optional<LabirinthSolver::Result> cached;
+		};
+
+		using File = std::string;
+		using Emit = Pipeline<File>::Emit;
+
+		//bounds on the work waiting between the stages, so that a fast
+		//scanner or loader cannot pile up labirinths faster than they are solved;
+		//the solutions are taken by a single collecting stage
+		static constexpr std::size_t MAX_PENDING_FILES = 1024;
+		static constexpr std::size_t MAX_LOADED_LABIRINTHS = 64;
 
 	public:
 		using Result = std::vector<LabirinthSolver::Result>;
 
+		struct Solution
+		{
+			std::string source;
+			LabirinthSolver::Result paths;
+		};
+
+		//called from a single thread, one solution at a time
+		using OnSolution = std::function<void(Solution)>;
+
+		enum class Ordering
+		{
+			//the results are sorted by the paths of their files, so that
+			//they come in the same order in every run, however many
+			//threads scan; only the collected result can be put in this order
+			bySource,
+			//the results follow the order in which the solvers finished,
+			//which saves the sorting at the end of a run
+			asSolved
+		};
+
+		//the engines differ in what they return, not only in how fast,
+		//so results of different engines are not comparable
+		enum class Engine
+		{
+			//the paths LabirinthSolver finds
+			labirinthSolver,
+			//only one shortest path to every end, as U, D, L, R moves,
+			//not the paths of LabirinthSolver; see BitParallelSolver
+			bitParallel,
+			//every path to the first end it reaches, as U, D, L, R moves;
+			//see AllPathsSolver
+			allPaths
+		};
+
+		struct Options
+		{
+			std::size_t loaders = 1;
+			std::size_t solvers = std::max(1u, std::thread::hardware_concurrency());
+			Ordering ordering = Ordering::bySource;
+			//walk the subdirectories too, with that many scanning threads
+			bool recursive = false;
+			std::size_t scanners = std::max(1u, std::thread::hardware_concurrency());
+			//selects the result mode as well, see Engine
+			Engine engine = Engine::labirinthSolver;
+			//the cells the bit-parallel and all-paths engines tell apart
+			BitParallelSolver::Alphabet alphabet;
+			//the bit-parallel engine searches a labirinth of at least
+			//that many cells with searchThreads threads of its own,
+			//started by each of the solvers
+			std::size_t minParallelCells = BitParallelSolver::MIN_PARALLEL_CELLS;
+			std::size_t searchThreads = std::max(1u, std::thread::hardware_concurrency());
+			//the all-paths engine does so from that many cells on,
+			//searching the smaller labirinths with the solver alone
+			std::size_t minParallelPathCells = AllPathsSolver::MIN_PARALLEL_CELLS;
+			//the all-paths engine returns at most that many paths
+			std::size_t maxPaths = AllPathsSolver::MAX_PATHS;
+			//the file of the result cache, none if empty; a result of the
+			//all-paths engine with maxPaths paths is not cached, as it may be cut off
+			std::string cacheFile;
+			//filled by every run with the stages "files", "load",
+			//"solve" and "collect", if set; must outlive the runs
+			PipelineMetrics* metrics = nullptr;
+		};
+
 		PipelinedLabirinthSolver() = default;
-		explicit PipelinedLabirinthSolver(const Self& source);
+		explicit PipelinedLabirinthSolver(const Options& options);
+		PipelinedLabirinthSolver(const Self& source) = default;
 		~PipelinedLabirinthSolver() = default;
 
-		Self& operator=(const Self& rhs);
+		Self& operator=(const Self& rhs) = default;
 
-		Result operator()(const std::string& path);
+		//collects all solutions and returns them once every file is solved
+		Result operator()(const std::string& path) const;
+		//hands over every solution as soon as it is ready
+		void operator()(const std::string& path, const OnSolution& onSolution) const;
+		//solves every file the watcher reports, without rescanning,
+		//until watcher.stop() is called; Ordering does not apply
+		void watch(DirectoryWatcher& watcher, const OnSolution& onSolution) const;
 
 	private:
-		void scanForTextFiles(const std::string& path);
-		void loadFiles();
-		void solveLabirinths();
-		void clear() noexcept;
-
-		void load(std::unique_ptr<std::optional<std::string>> filename);
-		void solve(std::unique_ptr<std::optional<Labirinth>> lab);
+		using Solutions = std::vector<Solution>;
 
-		void insertSentinelFile();
-		void insertSentinelLabirinth();
+		void solveAll(const std::function<void(const Emit&)>& findFiles, const OnSolution& onSolution) const;
+		void scanForTextFiles(const std::string& path, const Emit& emit) const;
+		Result toResult(Solutions solutions) const;
 
-		template <typename Optional>
-		inline static bool isSentinel(const Optional& x) noexcept { return !x->has_value(); }
+		static std::optional<Labirinth> load(File file, const ResultCache* cache, ResultCache::Key seed);
+		std::optional<Solution> solve(Labirinth labirinth, ResultCache* cache) const;
+		LabirinthSolver::Result solve(const Grid& grid) const;
+		ResultCache::Key cacheSeed() const;
+		bool mayBeTruncated(const LabirinthSolver::Result& paths) const noexcept;
+		static void store(ResultCache& cache, ResultCache::Key hash, const Solution& solution);
 
 	private:
-		Result result;
-		ThreadSafeQueue<std::optional<Labirinth>> labirinths;
-		ThreadSafeQueue<std::optional<std::string>> files;
-		std::atomic<bool> abort = false;
+		Options options;
 	};
 }
 
@@ -0,0 +1,160 @@
+#include "ResultCache.h"
+#include "MappedFile.h"
+#include "XXHash64.h"
+#include <cstring>
+
+namespace IDragnev::Multithreading
+{
+	namespace
+	{
+		constexpr auto HEADER_SIZE = sizeof(std::uint32_t) + sizeof(std::uint32_t) + sizeof(std::uint64_t);
+		constexpr auto CHECKSUM_SIZE = sizeof(std::uint64_t);
+
+		template <typename Integer>
+		void write(std::string& out, Integer value)
+		{
+			char bytes[sizeof(Integer)];
+			std::memcpy(bytes, &value, sizeof(Integer));
+			out.append(bytes, sizeof(Integer));
+		}
+
+		//reads an integer from the front of in and drops it,
+		//returns std::nullopt if in is too short
+		template <typename Integer>
+		std::optional<Integer> read(std::string_view& in) noexcept
+		{
+			if (in.size() < sizeof(Integer))
+			{
+				return std::nullopt;
+			}
+
+			Integer value;
+			std::memcpy(&value, in.data(), sizeof(Integer));
+			in.remove_prefix(sizeof(Integer));
+
+			return value;
+		}
+	}
+
+	//the file is opened for appending first, so that it exists when mapped
+	ResultCache::ResultCache(const std::string& filename) :
+		file{ filename }
+	{
+		auto contents = MappedFile{ filename };
+		load(contents.getContents());
+	}
+
+	//on a record that does not check out, the reading
+	//resumes from the next magic number in the file
+	void ResultCache::load(std::string_view contents)
+	{
+		const auto magic = std::string_view{ reinterpret_cast<const char*>(&RECORD_MAGIC), sizeof(RECORD_MAGIC) };
+
+		for (auto position = contents.find(magic);
+			 position != std::string_view::npos;
+			 position = contents.find(magic, position))
+		{
+			auto record = contents.substr(position + sizeof(RECORD_MAGIC));
+			auto bodySize = read<std::uint32_t>(record);
+			auto key = read<std::uint64_t>(record);
+
+			if (bodySize && key && record.size() >= *bodySize + CHECKSUM_SIZE)
+			{
+				auto body = record.substr(0, *bodySize);
+				auto rest = record.substr(*bodySize);
+
+				if (read<std::uint64_t>(rest) == xxHash64(body, *key))
+				{
+					if (auto value = deserialize(body); value)
+					{
+						entries.try_emplace(*key, std::move(*value));
+						position += HEADER_SIZE + *bodySize + CHECKSUM_SIZE;
+						continue;
+					}
+				}
+			}
+
+			++position;
+		}
+	}
+
+	auto ResultCache::find(Key key) const -> std::optional<Value>
+	{
+		auto lock = SharedLock(mutex);
+
+		if (auto it = entries.find(key); it != std::cend(entries))
+		{
+			return it->second;
+		}
+
+		return std::nullopt;
+	}
+
+	void ResultCache::insert(Key key, const Value& value)
+	{
+		{
+			auto lock = UniqueLock(mutex);
+			if (!entries.try_emplace(key, value).second)
+			{
+				return;
+			}
+		}
+
+		//appends need no lock, each one is a single write
+		file.append(serialize(key, value));
+	}
+
+	std::size_t ResultCache::getSize() const
+	{
+		auto lock = SharedLock(mutex);
+		return entries.size();
+	}
+
+	std::string ResultCache::serialize(Key key, const Value& value)
+	{
+		auto body = std::string{};
+		write(body, static_cast<std::uint32_t>(std::size(value)));
+
+		for (const auto& path : value)
+		{
+			auto characters = std::string_view{ path };
+			write(body, static_cast<std::uint32_t>(characters.size()));
+			body.append(characters);
+		}
+
+		auto record = std::string{};
+		record.reserve(HEADER_SIZE + body.size() + CHECKSUM_SIZE);
+		write(record, RECORD_MAGIC);
+		write(record, static_cast<std::uint32_t>(body.size()));
+		write(record, key);
+		record.append(body);
+		write(record, xxHash64(body, key));
+
+		return record;
+	}
+
+	auto ResultCache::deserialize(std::string_view body) -> std::optional<Value>
+	{
+		auto count = read<std::uint32_t>(body);
+		if (!count)
+		{
+			return std::nullopt;
+		}
+
+		auto result = Value{};
+
+		for (auto i = 0u; i < *count; ++i)
+		{
+			auto length = read<std::uint32_t>(body);
+			if (!length || body.size() < *length)
+			{
+				return std::nullopt;
+			}
+
+			result.emplace_back(body.substr(0, *length));
+			body.remove_prefix(*length);
+		}
+
+		return body.empty() ? std::optional<Value>{ std::move(result) } : std::nullopt;
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef __RESULT_CACHE_H_INCLUDED__
+#define __RESULT_CACHE_H_INCLUDED__
+
+#include "LabirinthSolver.h"
+#include "AppendOnlyFile.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+
+namespace IDragnev::Multithreading
+{
+	//Solutions of labirinths keyed by a hash of their files, kept in memory
+	//and persisted in a file of appended records:
+	//    magic (4 bytes) | body size (4) | key (8) | body | checksum (8)
+	//where the body is the count of paths followed by every path
+	//as its length (4) and characters, and the checksum is the xxHash64
+	//of the body seeded with the key. The integers are in native byte order.
+	//Several processes may read and append to the same file at once: a
+	//record is written with a single append and a reader skips any record
+	//whose checksum does not match, such as one still being written.
+	class ResultCache
+	{
+	private:
+		using SharedLock = std::shared_lock<std::shared_mutex>;
+		using UniqueLock = std::unique_lock<std::shared_mutex>;
+
+		static constexpr std::uint32_t RECORD_MAGIC = 0x3143524C; //"LRC1"
+
+	public:
+		using Key = std::uint64_t;
+		using Value = LabirinthSolver::Result;
+
+		//reads the records already in the file, creating it if needed
+		explicit ResultCache(const std::string& filename);
+		ResultCache(const ResultCache&) = delete;
+		~ResultCache() = default;
+
+		ResultCache& operator=(const ResultCache&) = delete;
+
+		std::optional<Value> find(Key key) const;
+		//appends to the file only if the key is new
+		void insert(Key key, const Value& value);
+		std::size_t getSize() const;
+
+	private:
+		void load(std::string_view contents);
+
+		static std::string serialize(Key key, const Value& value);
+		static std::optional<Value> deserialize(std::string_view body);
+
+	private:
+		mutable std::shared_mutex mutex;
+		std::unordered_map<Key, Value> entries;
+		AppendOnlyFile file;
+	};
+}
+
+#endif //__RESULT_CACHE_H_INCLUDED__
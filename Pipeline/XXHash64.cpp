@@ -0,0 +1,114 @@
+#include "XXHash64.h"
+#include <cstring>
+
+namespace IDragnev::Multithreading
+{
+	namespace
+	{
+		constexpr std::uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+		constexpr std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+		constexpr std::uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+		constexpr std::uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+		constexpr std::uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+		inline std::uint64_t rotateLeft(std::uint64_t x, unsigned bits) noexcept
+		{
+			return (x << bits) | (x >> (64 - bits));
+		}
+
+		//memcpy keeps the unaligned reads well-defined
+		inline std::uint64_t read64(const char* p) noexcept
+		{
+			std::uint64_t result;
+			std::memcpy(&result, p, sizeof(result));
+			return result;
+		}
+
+		inline std::uint32_t read32(const char* p) noexcept
+		{
+			std::uint32_t result;
+			std::memcpy(&result, p, sizeof(result));
+			return result;
+		}
+
+		inline std::uint64_t round(std::uint64_t accumulator, std::uint64_t input) noexcept
+		{
+			accumulator += input * PRIME2;
+			accumulator = rotateLeft(accumulator, 31);
+			return accumulator * PRIME1;
+		}
+
+		inline std::uint64_t mergeRound(std::uint64_t hash, std::uint64_t accumulator) noexcept
+		{
+			hash ^= round(0, accumulator);
+			return hash * PRIME1 + PRIME4;
+		}
+
+		inline std::uint64_t avalanche(std::uint64_t hash) noexcept
+		{
+			hash ^= hash >> 33;
+			hash *= PRIME2;
+			hash ^= hash >> 29;
+			hash *= PRIME3;
+			hash ^= hash >> 32;
+
+			return hash;
+		}
+	}
+
+	std::uint64_t xxHash64(std::string_view data, std::uint64_t seed) noexcept
+	{
+		auto p = data.data();
+		const auto end = p + data.size();
+		auto hash = std::uint64_t{ 0 };
+
+		if (data.size() >= 32)
+		{
+			auto v1 = seed + PRIME1 + PRIME2;
+			auto v2 = seed + PRIME2;
+			auto v3 = seed;
+			auto v4 = seed - PRIME1;
+
+			for (const auto limit = end - 32; p <= limit; p += 32)
+			{
+				v1 = round(v1, read64(p));
+				v2 = round(v2, read64(p + 8));
+				v3 = round(v3, read64(p + 16));
+				v4 = round(v4, read64(p + 24));
+			}
+
+			hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+			hash = mergeRound(hash, v1);
+			hash = mergeRound(hash, v2);
+			hash = mergeRound(hash, v3);
+			hash = mergeRound(hash, v4);
+		}
+		else
+		{
+			hash = seed + PRIME5;
+		}
+
+		hash += static_cast<std::uint64_t>(data.size());
+
+		for (; p + 8 <= end; p += 8)
+		{
+			hash ^= round(0, read64(p));
+			hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+		}
+
+		if (p + 4 <= end)
+		{
+			hash ^= static_cast<std::uint64_t>(read32(p)) * PRIME1;
+			hash = rotateLeft(hash, 23) * PRIME2 + PRIME3;
+			p += 4;
+		}
+
+		for (; p < end; ++p)
+		{
+			hash ^= static_cast<std::uint64_t>(static_cast<unsigned char>(*p)) * PRIME5;
+			hash = rotateLeft(hash, 11) * PRIME1;
+		}
+
+		return avalanche(hash);
+	}
+}
@@ -0,0 +1,15 @@
+#ifndef __XXHASH64_H_INCLUDED__
+#define __XXHASH64_H_INCLUDED__
+
+#include <cstdint>
+#include <string_view>
+
+namespace IDragnev::Multithreading
+{
+	//The 64-bit xxHash of the bytes of data: a fast non-cryptographic hash,
+	//suitable for telling apart file contents but not for security.
+	//Matches the reference implementation on little-endian machines.
+	std::uint64_t xxHash64(std::string_view data, std::uint64_t seed = 0) noexcept;
+}
+
+#endif //__XXHASH64_H_INCLUDED__
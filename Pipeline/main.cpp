@@ -3,24 +3,20 @@
 
 using Solver = IDragnev::Multithreading::PipelinedLabirinthSolver;
 
-auto print = [](auto solutions)
+//prints every labirinth as soon as it is solved
+auto print = [](Solver::Solution solution)
 {
-	auto i = 1u;
-	for (const auto& s : solutions)
-	{
-		std::cout << "labirinth " << i++ << " paths:\n";
-		
-		for (const auto& path : s)
-		{
-			std::cout << path.c_str() << " ";
-		}
+	std::cout << "labirinth " << solution.source << " paths:\n";
 
-		std::cout << "\n\n";
+	for (const auto& path : solution.paths)
+	{
+		std::cout << path.c_str() << " ";
 	}
+
+	std::cout << "\n\n";
 };
 
 int main()
 {
-	print(Solver{}("Labirinths"));	
+	Solver{}("Labirinths", print);
 }
-
@@ -92,8 +92,7 @@ namespace IDragnev::Multithreading
 
 	std::optional<Function> ThreadPool::extractTaskFromGlobalQueue()
 	{
-		auto result = mainQueue.extractFront();			
-		return result != nullptr ? std::move(*result) : std::nullopt; 
+		return mainQueue.tryPop();
 	}
 
 	std::optional<Function> ThreadPool::stealTaskFromOtherThread()
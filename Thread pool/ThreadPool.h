@@ -4,7 +4,7 @@
 #include "Function.h"
 #include "SmartThread.h"
 #include "WorkStealableQueue.h"
-#include "Lock-free data structures\Queue\Queue\LockFreeQueue.h"
+#include "Concurrent queue\ConcurrentQueue.h"
 #include <type_traits>
 
 namespace IDragnev::Multithreading
@@ -54,7 +54,7 @@ namespace IDragnev::Multithreading
 	private:
 		std::atomic<bool> isDone;
 		std::size_t numberOfThreads;
-		LockFreeQueue<Function> mainQueue;
+		ConcurrentQueue<Function, LockFreeMpmc> mainQueue;
 		WorkStealableQueuePtrs threadLocalQueues;
 		Threads threads;
 	};
@@ -81,7 +81,7 @@ namespace IDragnev::Multithreading
 		}
 		else
 		{
-			mainQueue.enqueue(std::move(task));
+			mainQueue.push(std::move(task));
 		}
 	}
 }